@@ -0,0 +1,43 @@
+#include <filesystem>
+#include <iostream>
+
+import mdefparser;
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cout << "Usage: " << argv[0] << " <path-to-def>" << std::endl;
+    return 0;
+  }
+
+  auto parser = mugen::def::DefParserWin{};
+
+  std::filesystem::path path{argv[1]};
+
+  // Parse all params with arcade storyboards
+  try {
+    auto def = mugen::def::parse(parser, path, {.followArcade = true});
+
+    std::cout << "name: " << def.info.name << std::endl;
+    std::cout << "sprite: " << def.files.sprite.filename().string() << std::endl;
+
+    if (def.arcade.introStoryboard.has_value()) {
+      std::cout << "intro scenes: " << def.arcade.introStoryboard->sceneCount << std::endl;
+    } else {
+      std::cout << "intro scenes: (null)" << std::endl;
+    }
+
+  } catch (const mugen::def::FileIOError& e) {
+    // Throw FileIOError if path is not exist
+    std::cerr << e.what() << std::endl;
+    return 1;
+  } catch (const mugen::def::MissingKeyError& e) {
+    // Throw MissingKeyError if def has not required parameter
+    std::cerr << e.what() << std::endl;
+    return 1;
+  } catch (const mugen::def::DequotationError& e) {
+    // Throw DequotationError if dequotation failed
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  // All errors are sub class of std::runtime_error
+}
@@ -0,0 +1,99 @@
+/**
+ * @file air.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_AIR_HPP__
+#define MDEFPARSER_AIR_HPP__
+
+#include "mdefparser/mdefparser.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+struct AirActionRange {
+  std::int32_t number;
+  // [Begin Action N] の行頭から次のセクションの直前まで
+  std::uint64_t begin;
+  std::uint64_t end;
+};
+
+struct AirIndex {
+  // アクション番号の昇順、重複は先に現れたもののみ
+  std::vector<AirActionRange> actions;
+
+  const AirActionRange* find(std::int32_t number) const noexcept;
+};
+
+struct AirBox {
+  std::int32_t left;
+  std::int32_t top;
+  std::int32_t right;
+  std::int32_t bottom;
+};
+
+struct AirFrame {
+  std::int32_t group;
+  std::int32_t index;
+  std::int32_t x;
+  std::int32_t y;
+  std::int32_t time;
+  std::string flip;
+  std::string blend;
+  std::vector<AirBox> clsn1;
+  std::vector<AirBox> clsn2;
+};
+
+struct AirAction {
+  std::int32_t number;
+  std::vector<AirFrame> frames;
+  std::optional<std::size_t> loopStart;
+};
+
+class AirReader {
+ public:
+  AirReader(const AirReader&) = delete;
+  AirReader& operator=(const AirReader&) = delete;
+
+  AirReader(AirReader&&) = default;
+  AirReader& operator=(AirReader&&) = default;
+
+  explicit AirReader() noexcept;
+
+  // ファイルを 1 回走査してアクション番号とその範囲のみを集める
+  AirIndex read_index(const std::filesystem::path& path);
+
+  // read_index() で得た範囲のみを読み込んでデコードする
+  AirAction read_action(const std::filesystem::path& path, const AirActionRange& range);
+};
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/air.cpp"
+#endif
+
+#endif  // MDEFPARSER_AIR_HPP__
@@ -0,0 +1,66 @@
+/**
+ * @file async.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_ASYNC_HPP__
+#define MDEFPARSER_ASYNC_HPP__
+
+// スレッドを使うパース (followArcade を指定できる parse() と parse_batch())
+// mdefparser.h だけを読み込む翻訳単位に <thread> や <future> を読み込ませないように分けている
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/batch.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+struct ParseOptions {
+  // [Arcade] の intro.storyboard / ending.storyboard も併せてパースする
+  // 参照先が存在しない、またはパースできない storyboard は std::nullopt となる
+  bool followArcade = false;
+};
+
+// storyboard は parser と同じ FileSource から読み込む
+MugenDefWin parse(DefParserWin& parser, const std::filesystem::path& path, const ParseOptions& options);
+
+// jobs == 0 の場合はハードウェアスレッド数で並列にパースする
+std::vector<BatchResult<MugenDefWin>> parse_batch(DefParserWin& parser, std::span<const std::filesystem::path> paths, unsigned jobs = 0);
+
+// パースが終わったものから順に callback(paths 内の位置, 結果) を呼び出す
+// callback は複数のスレッドから同時に呼び出される
+void parse_batch(DefParserWin& parser,
+                 std::span<const std::filesystem::path> paths,
+                 const std::function<void(std::size_t, BatchResult<MugenDefWin>&&)>& callback,
+                 unsigned jobs = 0);
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/async.cpp"
+#endif
+
+#endif  // MDEFPARSER_ASYNC_HPP__
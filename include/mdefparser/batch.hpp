@@ -0,0 +1,46 @@
+/**
+ * @file batch.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_BATCH_HPP__
+#define MDEFPARSER_BATCH_HPP__
+
+#include <exception>
+#include <optional>
+
+namespace mugen {
+namespace def {
+
+// 複数ファイルをまとめて処理する API の 1 件分の結果
+// 失敗した場合は value の代わりに送出された例外を error に保持する
+template <class T>
+struct BatchResult {
+  std::optional<T> value;
+  std::exception_ptr error;
+
+  explicit operator bool() const noexcept {
+    return value.has_value();
+  }
+};
+
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_BATCH_HPP__
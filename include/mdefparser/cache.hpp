@@ -0,0 +1,133 @@
+/**
+ * @file cache.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_CACHE_HPP__
+#define MDEFPARSER_CACHE_HPP__
+
+#include "mdefparser/mdefparser.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+struct CacheStats {
+  std::uint64_t hits;
+  std::uint64_t misses;
+  std::uint64_t evictions;
+  std::size_t size;
+};
+
+// パース結果をパスごとに保持する DefParserWin
+// キャッシュはパスのハッシュ値で分割した LRU で、取り出す際にファイルのサイズと更新日時が変わっていないかを確認する
+// 同じファイルへの要求が同時に来た場合はパースを 1 度だけ行い、他の要求はその結果を待つ
+// 失敗したパースの結果はキャッシュしない
+class CachingDefParser {
+ public:
+  CachingDefParser(const CachingDefParser&) = delete;
+  CachingDefParser& operator=(const CachingDefParser&) = delete;
+
+  CachingDefParser(CachingDefParser&&) = delete;
+  CachingDefParser& operator=(CachingDefParser&&) = delete;
+
+  // capacity は全体で保持する件数の上限 (各シャードに均等に割り当てる)
+  explicit CachingDefParser(std::size_t capacity = 1024, std::size_t shardCount = 16, const ParseLimits& limits = ParseLimits{});
+
+  std::shared_ptr<const MugenDefWin> parse(const std::filesystem::path& path);
+
+  // キャッシュした parse() の結果から取り出す
+  // 必須項目が欠けているなどで parse() に失敗するファイルは DefParserWin::parse_item() で直接読み込む
+  template <DefParseKey Key>
+  typename DefItemType<Key>::type parse_item(const std::filesystem::path& path);
+
+  void invalidate(const std::filesystem::path& path);
+  void clear();
+
+  CacheStats stats() const;
+
+ private:
+  struct Node {
+    std::uint64_t size;
+    std::int64_t modified;
+    std::uint64_t generation;
+    std::shared_future<std::shared_ptr<const MugenDefWin>> result;
+    std::list<std::filesystem::path::string_type>::iterator lru;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<std::filesystem::path::string_type, Node> nodes;
+    // 先頭が最も新しい
+    std::list<std::filesystem::path::string_type> lru;
+  };
+
+  Shard& shard_for(const std::filesystem::path::string_type& key) noexcept;
+  void erase_if_generation(Shard& shard, const std::filesystem::path::string_type& key, std::uint64_t generation);
+
+  DefParserWin parser_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::size_t shardCapacity_;
+  std::atomic<std::uint64_t> generation_;
+  std::atomic<std::uint64_t> hits_;
+  std::atomic<std::uint64_t> misses_;
+  std::atomic<std::uint64_t> evictions_;
+};
+
+template <DefParseKey Key>
+typename DefItemType<Key>::type CachingDefParser::parse_item(const std::filesystem::path& path) {
+  std::shared_ptr<const MugenDefWin> def{};
+  try {
+    def = parse(path);
+  } catch (const MissingKeyError&) {
+    return parser_.parse_item<Key>(path);
+  } catch (const DequotationError&) {
+    return parser_.parse_item<Key>(path);
+  }
+
+  const auto& item = get_item<Key>(*def);
+  if constexpr (is_required_item<Key>) {
+    return item;
+  } else {
+    if (!item) {
+      throw MissingKeyError{"Required parameter does not exist."};
+    }
+    return *item;
+  }
+}
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/cache.cpp"
+#endif
+
+#endif  // MDEFPARSER_CACHE_HPP__
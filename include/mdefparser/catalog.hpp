@@ -0,0 +1,116 @@
+/**
+ * @file catalog.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_CATALOG_HPP__
+#define MDEFPARSER_CATALOG_HPP__
+
+#include "mdefparser/mdefparser.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+struct CatalogEntry {
+  std::filesystem::path path;
+  MugenDefWin def;
+};
+
+enum class CatalogField {
+  Name,
+  DisplayName,
+  Author,
+};
+
+// パース済みの def をまとめて保持し、名前・作者・参照ファイルで検索するためのコンテナ
+// 構築時に索引を作るので、検索は索引の参照のみで終わる
+// 検索はすべて ASCII の大文字小文字を区別せず、結果は該当する entries() の位置の列を返す
+// CP932 の 2 バイト文字 (2 バイト目が英字のものを含む) は小文字にせずそのまま比較する
+class DefCatalog {
+ public:
+  DefCatalog(const DefCatalog&) = delete;
+  DefCatalog& operator=(const DefCatalog&) = delete;
+
+  DefCatalog(DefCatalog&&) = default;
+  DefCatalog& operator=(DefCatalog&&) = default;
+
+  explicit DefCatalog() noexcept;
+  explicit DefCatalog(std::vector<CatalogEntry> entries, unsigned jobs = 0);
+
+  std::span<const CatalogEntry> entries() const noexcept {
+    return entries_;
+  }
+  std::size_t size() const noexcept {
+    return entries_.size();
+  }
+  const CatalogEntry& operator[](std::size_t index) const noexcept {
+    return entries_[index];
+  }
+
+  std::span<const std::uint32_t> find(CatalogField field, std::string_view value) const;
+  // 結果は値の辞書順に並ぶ
+  std::span<const std::uint32_t> find_prefix(CatalogField field, std::string_view prefix) const;
+
+  // files.* の値を def ファイルのあるフォルダからの相対パスとして解決したものと比較する
+  // 同じファイルを複数の項目が参照していても結果には 1 度だけ含まれる
+  std::span<const std::uint32_t> find_file(const std::filesystem::path& file) const;
+
+ private:
+  // ids[i] は keys[i] を持つ entries_ の位置
+  // 同じキーは連続して並び、名前などの索引では keys は昇順になる
+  // 検索する値を小文字の文字列に変換せずに引くため、ASCII の大文字小文字を区別せずに比較する
+  struct KeyHash {
+    std::size_t operator()(std::string_view key) const noexcept;
+  };
+  struct KeyEqual {
+    bool operator()(std::string_view a, std::string_view b) const noexcept;
+  };
+
+  struct Index {
+    std::vector<std::string> keys;
+    std::vector<std::uint32_t> ids;
+    std::unordered_map<std::string_view, std::pair<std::uint32_t, std::uint32_t>, KeyHash, KeyEqual> exact;
+  };
+
+  std::span<const std::uint32_t> find_exact(const Index& index, std::string_view key) const;
+
+  std::vector<CatalogEntry> entries_;
+  std::array<Index, 3> fieldIndexes_;
+  Index fileIndex_;
+};
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/catalog.cpp"
+#endif
+
+#endif  // MDEFPARSER_CATALOG_HPP__
@@ -0,0 +1,88 @@
+/**
+ * @file cmd.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_CMD_HPP__
+#define MDEFPARSER_CMD_HPP__
+
+#include "mdefparser/mdefparser.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+// セクション見出しの行頭から次のセクションの直前まで
+// 行番号は 1 始まりで、endLine は次のセクションの見出しの行 (範囲に含まない)
+struct CmdRange {
+  std::uint64_t begin;
+  std::uint64_t end;
+  std::uint32_t beginLine;
+  std::uint32_t endLine;
+};
+
+struct CmdCommand {
+  // name = の値 (引用符は除く)
+  std::string name;
+  CmdRange range;
+};
+
+struct CmdStateController {
+  // [State -1, label] の label
+  std::string label;
+  CmdRange range;
+};
+
+struct CmdIndex {
+  // name の昇順、同じ名前の [Command] はファイル内の順 (MUGEN では同じ名前を複数定義できる)
+  std::vector<CmdCommand> commands;
+  // ファイル内の順
+  std::vector<CmdStateController> stateControllers;
+
+  std::span<const CmdCommand> find(std::string_view name) const noexcept;
+};
+
+class CmdReader {
+ public:
+  CmdReader(const CmdReader&) = delete;
+  CmdReader& operator=(const CmdReader&) = delete;
+
+  CmdReader(CmdReader&&) = default;
+  CmdReader& operator=(CmdReader&&) = default;
+
+  explicit CmdReader() noexcept;
+
+  // ファイルを 1 回走査して [Command] の名前と [State -1] のステートコントローラーの範囲を集める
+  CmdIndex read_index(const std::filesystem::path& path);
+};
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/cmd.cpp"
+#endif
+
+#endif  // MDEFPARSER_CMD_HPP__
@@ -0,0 +1,76 @@
+/**
+ * @file cns.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_CNS_HPP__
+#define MDEFPARSER_CNS_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/batch.hpp"
+#include "mdefparser/catalog.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+struct CnsConstant {
+  // セクション名 ("data", "size", "velocity", "movement") とキーは小文字
+  std::string section;
+  std::string key;
+  // コメントと前後の空白を除いた値
+  std::string value;
+};
+
+struct CnsConstants {
+  // ファイル内の順
+  std::vector<CnsConstant> values;
+
+  // 同じキーが複数ある場合は最初のもの (section と key は ASCII の大文字小文字を区別しない)
+  const std::string* find(std::string_view section, std::string_view key) const noexcept;
+
+  // 値をカンマで区切った index 番目を数値として返す (例: number("size", "head.pos", 1))
+  std::optional<double> number(std::string_view section, std::string_view key, std::size_t index = 0) const noexcept;
+};
+
+// cns の [Data], [Size], [Velocity], [Movement] の定数を読み込む
+// 4 つのセクションを読み終えるか [Statedef] に出会った時点で読むのを止めるため、ステート定義は読まない
+CnsConstants parse_cns_constants(const std::filesystem::path& path);
+
+// jobs == 0 の場合はハードウェアスレッド数で並列に読み込む
+std::vector<BatchResult<CnsConstants>> parse_cns_constants_batch(std::span<const std::filesystem::path> paths, unsigned jobs = 0);
+
+// entries の files.cns を def ファイルのあるフォルダからの相対パスとして解決して読み込む
+std::vector<BatchResult<CnsConstants>> parse_cns_constants_batch(std::span<const CatalogEntry> entries, unsigned jobs = 0);
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/cns.cpp"
+#endif
+
+#endif  // MDEFPARSER_CNS_HPP__
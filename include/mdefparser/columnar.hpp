@@ -0,0 +1,178 @@
+/**
+ * @file columnar.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_COLUMNAR_HPP__
+#define MDEFPARSER_COLUMNAR_HPP__
+
+#include "mdefparser/mdefparser.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+class PresenceBitmap {
+ public:
+  bool test(std::size_t index) const noexcept {
+    return (words_[index / 64] >> (index % 64)) & 1;
+  }
+
+  std::size_t size() const noexcept {
+    return size_;
+  }
+
+  std::size_t count() const noexcept {
+    std::size_t count = 0;
+    for (auto word : words_) {
+      count += static_cast<std::size_t>(std::popcount(word));
+    }
+    return count;
+  }
+
+  std::span<const std::uint64_t> words() const noexcept {
+    return words_;
+  }
+
+  void push_back(bool value) {
+    if (size_ % 64 == 0) {
+      words_.push_back(0);
+    }
+    if (value) {
+      words_.back() |= std::uint64_t{1} << (size_ % 64);
+    }
+    ++size_;
+  }
+
+  void reserve(std::size_t size) {
+    words_.reserve((size + 63) / 64);
+  }
+
+ private:
+  std::vector<std::uint64_t> words_;
+  std::size_t size_ = 0;
+};
+
+// 文字列・パスの列: i 行目の値は blob[offsets[i], offsets[i + 1])
+// パスは UTF-8 で格納する
+struct StringColumn {
+  PresenceBitmap presence;
+  std::vector<std::uint64_t> offsets{0};
+  std::string blob;
+
+  std::string_view view(std::size_t index) const noexcept {
+    return std::string_view{blob}.substr(offsets[index], offsets[index + 1] - offsets[index]);
+  }
+};
+
+// バージョンの列: 行が存在しない場合の値は 0
+struct VersionColumn {
+  PresenceBitmap presence;
+  std::vector<std::int32_t> months;
+  std::vector<std::int32_t> days;
+  std::vector<std::int32_t> years;
+};
+
+// pal.defaults の列: i 行目の値は values[offsets[i], offsets[i + 1])
+struct PalDefaultsColumn {
+  PresenceBitmap presence;
+  std::vector<std::uint32_t> offsets{0};
+  std::vector<std::int32_t> values;
+
+  std::span<const std::int32_t> view(std::size_t index) const noexcept {
+    return std::span<const std::int32_t>{values}.subspan(offsets[index], offsets[index + 1] - offsets[index]);
+  }
+};
+
+template <DefParseKey Key>
+using ColumnType = std::conditional_t<std::is_same_v<typename DefItemType<Key>::type, MugenDefVersion>,
+                                      VersionColumn,
+                                      std::conditional_t<Key == DefParseKey::PalDefaults, PalDefaultsColumn, StringColumn>>;
+
+// DefParseKey ごとに列を分けて保持するカタログ
+// 集計では必要な列だけを走査すればよい
+// followArcade で読み込んだ storyboard は保持しない
+class ColumnarCatalog {
+ public:
+  ColumnarCatalog(const ColumnarCatalog&) = delete;
+  ColumnarCatalog& operator=(const ColumnarCatalog&) = delete;
+
+  ColumnarCatalog(ColumnarCatalog&&) = default;
+  ColumnarCatalog& operator=(ColumnarCatalog&&) = default;
+
+  explicit ColumnarCatalog() noexcept;
+  explicit ColumnarCatalog(std::span<const MugenDefWin> defs);
+
+  void reserve(std::size_t rows);
+  void append(const MugenDefWin& def);
+
+  std::size_t size() const noexcept {
+    return size_;
+  }
+
+  // 1 行分を MugenDefWin に戻す
+  MugenDefWin row(std::size_t index) const;
+
+  template <DefParseKey Key>
+  const ColumnType<Key>& column() const noexcept {
+    if constexpr (Key == DefParseKey::VersionDate) {
+      return versionDate_;
+    } else if constexpr (Key == DefParseKey::MugenVersion) {
+      return mugenVersion_;
+    } else if constexpr (Key == DefParseKey::PalDefaults) {
+      return palDefaults_;
+    } else {
+      return strings_[static_cast<std::size_t>(Key)];
+    }
+  }
+
+  const PresenceBitmap& presence(DefParseKey key) const noexcept;
+
+ private:
+  template <DefParseKey Key>
+  ColumnType<Key>& mutable_column() noexcept {
+    return const_cast<ColumnType<Key>&>(column<Key>());
+  }
+
+  std::size_t size_;
+  // バージョンと pal.defaults の位置は使わない
+  std::array<StringColumn, DefParseKeyCount> strings_;
+  VersionColumn versionDate_;
+  VersionColumn mugenVersion_;
+  PalDefaultsColumn palDefaults_;
+};
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/columnar.cpp"
+#endif
+
+#endif  // MDEFPARSER_COLUMNAR_HPP__
@@ -0,0 +1,66 @@
+/**
+ * @file diff.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_DIFF_HPP__
+#define MDEFPARSER_DIFF_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/catalog.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+enum class DiffKind {
+  Added,
+  Removed,
+  Changed,
+};
+
+struct CatalogDiff {
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  DiffKind kind;
+  // before / after 内の位置 (Added の before と Removed の after は npos)
+  std::size_t before;
+  std::size_t after;
+  // Changed の場合に値が変わった項目 (storyboard の内容の変化は Intro / Ending に含める)
+  DefKeySet changedKeys;
+};
+
+// 同じパスのエントリー同士を比較し、追加・削除・変更されたものをパスの順に返す
+// エントリーごとのハッシュ値をパスで整列してから突き合わせるので、値を比較するのはハッシュ値が異なるもののみ
+// 同じパスのエントリーが複数ある場合は現れた順に対応させる
+// jobs == 0 の場合はハードウェアスレッド数で並列に処理する
+std::vector<CatalogDiff> diff_catalogs(std::span<const CatalogEntry> before, std::span<const CatalogEntry> after, unsigned jobs = 0);
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/diff.cpp"
+#endif
+
+#endif  // MDEFPARSER_DIFF_HPP__
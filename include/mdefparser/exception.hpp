@@ -48,6 +48,24 @@ class MissingKeyError : public std::runtime_error {
   explicit MissingKeyError(const char* message) noexcept : std::runtime_error{message} {}
 };
 
+class InvalidFormatError : public std::runtime_error {
+ public:
+  explicit InvalidFormatError(const std::string& message) noexcept : std::runtime_error{message} {}
+  explicit InvalidFormatError(const char* message) noexcept : std::runtime_error{message} {}
+};
+
+class InsufficientBufferError : public std::runtime_error {
+ public:
+  explicit InsufficientBufferError(const std::string& message) noexcept : std::runtime_error{message} {}
+  explicit InsufficientBufferError(const char* message) noexcept : std::runtime_error{message} {}
+};
+
+class LimitExceededError : public std::runtime_error {
+ public:
+  explicit LimitExceededError(const std::string& message) noexcept : std::runtime_error{message} {}
+  explicit LimitExceededError(const char* message) noexcept : std::runtime_error{message} {}
+};
+
 };  // namespace def
 };  // namespace mugen
 
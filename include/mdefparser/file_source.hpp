@@ -0,0 +1,76 @@
+/**
+ * @file file_source.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_FILE_SOURCE_HPP__
+#define MDEFPARSER_FILE_SOURCE_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+// DefParser が読み込みに使うインターフェースのみを宣言する (実装は source.hpp)
+
+namespace mugen {
+namespace def {
+
+struct FileStat {
+  std::uint64_t size;
+  // 変更を検出するためだけの値で、単位や基準はソースごとに異なる
+  std::int64_t modified;
+};
+
+// FileSource::open() で開いたファイル
+// read_at() は複数のスレッドから同時に呼び出される
+class FileHandle {
+ public:
+  virtual ~FileHandle() = default;
+
+  virtual std::uint64_t size() const noexcept = 0;
+
+  // 読み込めたバイト数を返す (EOF に達した場合は length 未満)
+  virtual std::size_t read_at(std::uint64_t offset, void* buffer, std::size_t length) const = 0;
+
+  // 内容全体が連続したメモリ上にある場合はそれを返す
+  virtual std::optional<std::string_view> contiguous() const noexcept {
+    return std::nullopt;
+  }
+};
+
+// DefParser がファイルを読み込む先
+// 実装は複数のスレッドから同時に呼び出されても安全でなければならない
+class FileSource {
+ public:
+  virtual ~FileSource() = default;
+
+  // 通常のファイルでない場合や存在しない場合は std::nullopt
+  virtual std::optional<FileStat> stat(const std::filesystem::path& path) const = 0;
+
+  // 開けない場合は FileIOError を投げる
+  virtual std::unique_ptr<FileHandle> open(const std::filesystem::path& path) const = 0;
+};
+
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_FILE_SOURCE_HPP__
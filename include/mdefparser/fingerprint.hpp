@@ -0,0 +1,93 @@
+/**
+ * @file fingerprint.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_FINGERPRINT_HPP__
+#define MDEFPARSER_FINGERPRINT_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/batch.hpp"
+#include "mdefparser/file_source.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+std::uint64_t xxh64(std::span<const std::byte> data, std::uint64_t seed = 0) noexcept;
+
+struct FileDigest {
+  std::filesystem::path path;
+  bool exists;
+  std::uint64_t size;
+  std::uint64_t hash;
+};
+
+// キャラクターパッケージの内容から求めたハッシュ値
+// フォルダ名や def の置き場所には依存しないので、別名で再配布されたものも同じ値になる
+struct PackageFingerprint {
+  std::uint64_t hash;
+  // 先頭は def ファイル、続いて files.* が参照するファイルを DefParseKey の順に重複なく並べる
+  // 参照先が存在しないファイルは exists == false として含める
+  std::vector<FileDigest> files;
+};
+
+class PackageHasher {
+ public:
+  PackageHasher(const PackageHasher&) = delete;
+  PackageHasher& operator=(const PackageHasher&) = delete;
+
+  PackageHasher(PackageHasher&&) = default;
+  PackageHasher& operator=(PackageHasher&&) = default;
+
+  explicit PackageHasher() noexcept;
+  // fingerprint() はファイルを source から読み込む (nullptr の場合はファイルシステムから直接読み込む)
+  explicit PackageHasher(std::shared_ptr<const FileSource> source) noexcept;
+
+  // 各ファイルを jobs 本のスレッドで並列に読み込む (jobs == 0 の場合はハードウェアスレッド数)
+  PackageFingerprint fingerprint(const std::filesystem::path& defPath, const MugenDefWin& def, unsigned jobs = 0);
+
+  // def のパースも含めてパッケージ単位で並列に処理する
+  // def は parser の制限でパースし、def も参照先のファイルも parser の読み込み元から読み込む
+  std::vector<BatchResult<PackageFingerprint>> fingerprint_batch(std::span<const std::filesystem::path> defPaths,
+                                                                 DefParserWin& parser,
+                                                                 unsigned jobs = 0);
+
+ private:
+  std::shared_ptr<const FileSource> source_;
+};
+
+// 同じ hash を持つものの位置をまとめる
+// 2 件以上のグループのみを返し、グループ内・グループ間とも位置の昇順に並ぶ (失敗したものは無視する)
+std::vector<std::vector<std::size_t>> group_duplicates(std::span<const BatchResult<PackageFingerprint>> fingerprints);
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/fingerprint.cpp"
+#endif
+
+#endif  // MDEFPARSER_FINGERPRINT_HPP__
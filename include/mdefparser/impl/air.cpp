@@ -0,0 +1,227 @@
+/**
+ * @file air.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/air.hpp"
+#include "mdefparser/impl/file.hpp"
+#include "mdefparser/impl/line_reader.hpp"
+#include "mdefparser/impl/tokenizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <utility>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+using namespace std::string_view_literals;
+
+static inline std::optional<std::int32_t> parse_air_action_number(std::string_view line) noexcept {
+  auto name = mugen::def::internal::section_name(line);
+  if (!name || !mugen::def::internal::istarts_with(*name, "begin action"sv)) {
+    return std::nullopt;
+  }
+  return mugen::def::internal::parse_number<std::int32_t>(name->substr("begin action"sv.size()));
+}
+
+struct AirClsnState {
+  std::vector<mugen::def::AirBox> defaults;
+  std::vector<mugen::def::AirBox> next;
+  bool hasNext = false;
+};
+
+static inline void decode_air_line(std::string_view line, mugen::def::AirAction& action, std::array<AirClsnState, 2>& clsn) {
+  if (mugen::def::internal::iequals(line, "loopstart"sv)) {
+    action.loopStart = action.frames.size();
+    return;
+  }
+
+  if (mugen::def::internal::istarts_with(line, "clsn"sv) && line.size() > 4 && (line[4] == '1' || line[4] == '2')) {
+    auto& state = clsn[line[4] - '1'];
+    auto rest = line.substr(5);
+
+    if (!rest.empty() && rest.front() == '[') {
+      // Clsn1[0] = left, top, right, bottom
+      auto kv = mugen::def::internal::split_key_value(line);
+      if (!kv) {
+        return;
+      }
+
+      std::array<std::string_view, 4> values{};
+      if (mugen::def::internal::split_values((*kv)[1], values) == 4) {
+        auto left = mugen::def::internal::parse_number<std::int32_t>(values[0]);
+        auto top = mugen::def::internal::parse_number<std::int32_t>(values[1]);
+        auto right = mugen::def::internal::parse_number<std::int32_t>(values[2]);
+        auto bottom = mugen::def::internal::parse_number<std::int32_t>(values[3]);
+        if (left && top && right && bottom) {
+          auto& boxes = state.hasNext ? state.next : state.defaults;
+          boxes.push_back(mugen::def::AirBox{.left = *left, .top = *top, .right = *right, .bottom = *bottom});
+        }
+      }
+    } else if (mugen::def::internal::istarts_with(rest, "default"sv)) {
+      // Clsn1Default: n 以降のフレームすべてに適用
+      state.defaults.clear();
+      state.hasNext = false;
+    } else {
+      // Clsn1: n 次のフレームのみに適用
+      state.next.clear();
+      state.hasNext = true;
+    }
+    return;
+  }
+
+  // group, index, x, y, time[, flip[, blend]]
+  std::array<std::string_view, 7> values{};
+  auto count = mugen::def::internal::split_values(line, values);
+  if (count < 5) {
+    return;
+  }
+
+  std::array<std::int32_t, 5> numbers{};
+  for (size_t i = 0; i < numbers.size(); ++i) {
+    auto number = mugen::def::internal::parse_number<std::int32_t>(values[i]);
+    if (!number) {
+      return;
+    }
+    numbers[i] = *number;
+  }
+
+  mugen::def::AirFrame frame{.group = numbers[0],
+                             .index = numbers[1],
+                             .x = numbers[2],
+                             .y = numbers[3],
+                             .time = numbers[4],
+                             .flip = std::string{count > 5 ? values[5] : ""sv},
+                             .blend = std::string{count > 6 ? values[6] : ""sv},
+                             .clsn1 = {},
+                             .clsn2 = {}};
+
+  for (size_t i = 0; i < clsn.size(); ++i) {
+    auto& state = clsn[i];
+    auto& boxes = i == 0 ? frame.clsn1 : frame.clsn2;
+    if (state.hasNext) {
+      boxes = std::move(state.next);
+      state.next.clear();
+      state.hasNext = false;
+    } else {
+      boxes = state.defaults;
+    }
+  }
+
+  action.frames.push_back(std::move(frame));
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE const mugen::def::AirActionRange* mugen::def::AirIndex::find(std::int32_t number) const noexcept {
+  auto it = std::partition_point(actions.begin(), actions.end(), [number](const mugen::def::AirActionRange& range) { return range.number < number; });
+  if (it == actions.end() || it->number != number) {
+    return nullptr;
+  }
+  return &*it;
+}
+
+MDEFPARSER_INLINE mugen::def::AirReader::AirReader() noexcept {}
+
+MDEFPARSER_INLINE mugen::def::AirIndex mugen::def::AirReader::read_index(const std::filesystem::path& path) {
+  mugen::def::internal::ReadOnlyFile file{path};
+  mugen::def::internal::LineReader reader{file};
+
+  std::vector<mugen::def::AirActionRange> actions{};
+  bool inAction = false;
+
+  std::string_view line;
+  while (reader.next(line)) {
+    // セクション行以外は読み飛ばすため、行頭の空白のみ除いて判定する
+    size_t start = line.find_first_not_of(" \t");
+    if (start == std::string_view::npos || line[start] != '[') {
+      continue;
+    }
+
+    if (inAction) {
+      actions.back().end = reader.line_offset();
+      inAction = false;
+    }
+
+    auto number = mugen::def::internal::parse_air_action_number(mugen::def::internal::trim_view(line));
+    if (number) {
+      actions.push_back(mugen::def::AirActionRange{.number = *number, .begin = reader.line_offset(), .end = file.size()});
+      inAction = true;
+    }
+  }
+
+  std::stable_sort(actions.begin(), actions.end(),
+                   [](const mugen::def::AirActionRange& a, const mugen::def::AirActionRange& b) { return a.number < b.number; });
+  actions.erase(std::unique(actions.begin(), actions.end(),
+                            [](const mugen::def::AirActionRange& a, const mugen::def::AirActionRange& b) { return a.number == b.number; }),
+                actions.end());
+
+  return mugen::def::AirIndex{.actions = std::move(actions)};
+}
+
+MDEFPARSER_INLINE mugen::def::AirAction mugen::def::AirReader::read_action(const std::filesystem::path& path,
+                                                                           const mugen::def::AirActionRange& range) {
+  mugen::def::internal::ReadOnlyFile file{path};
+  if (range.begin > range.end || range.end > file.size()) {
+    throw mugen::def::InvalidFormatError{"Action range is out of the file."};
+  }
+
+  std::string text(static_cast<size_t>(range.end - range.begin), '\0');
+  if (file.read_at(range.begin, text.data(), text.size()) != text.size()) {
+    throw mugen::def::FileIOError{"Can't read the specified file."};
+  }
+
+  mugen::def::AirAction action{.number = range.number, .frames = {}, .loopStart = std::nullopt};
+  std::array<mugen::def::internal::AirClsnState, 2> clsn{};
+
+  std::string_view rest{text};
+  bool first = true;
+  while (!rest.empty()) {
+    size_t newline = rest.find('\n');
+    auto line = mugen::def::internal::trim_view(rest.substr(0, newline));
+    rest = newline == std::string_view::npos ? std::string_view{} : rest.substr(newline + 1);
+
+    if (first) {
+      // 範囲の先頭行は [Begin Action N]
+      first = false;
+      if (mugen::def::internal::parse_air_action_number(line) != range.number) {
+        throw mugen::def::InvalidFormatError{"Action range does not point to the action."};
+      }
+      continue;
+    }
+    if (!line.empty()) {
+      mugen::def::internal::decode_air_line(line, action, clsn);
+    }
+  }
+
+  return action;
+}
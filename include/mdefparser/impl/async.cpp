@@ -0,0 +1,97 @@
+/**
+ * @file async.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/async.hpp"
+#include "mdefparser/impl/parallel.hpp"
+#include "mdefparser/impl/storyboard.hpp"
+#include "mdefparser/impl/visit_file.hpp"
+
+#include <functional>
+#include <future>
+#include <optional>
+#include <stdexcept>
+
+MDEFPARSER_INLINE mugen::def::MugenDefWin mugen::def::parse(mugen::def::DefParserWin& parser,
+                                                            const std::filesystem::path& path,
+                                                            const mugen::def::ParseOptions& options) {
+  auto def = parser.parse(path);
+  if (!options.followArcade) {
+    return def;
+  }
+
+  // storyboard のパスはキャラクターフォルダからの相対パス
+  // 参照先が存在しない場合も、パースできない場合も std::nullopt とし、キャラクターのパースは失敗させない
+  auto base = path.parent_path();
+  auto follow = [&parser, &base](const std::optional<std::filesystem::path>& storyboard) -> std::optional<mugen::def::StoryboardDef> {
+    if (!storyboard || storyboard->empty()) {
+      return std::nullopt;
+    }
+
+    // def と同じく parser の source から読み込む
+    try {
+      return mugen::def::internal::visit_file(parser.source().get(), mugen::def::internal::resolve_def_path(base, *storyboard), [](const auto& file) {
+        return mugen::def::internal::parse_storyboard(file);
+      });
+    } catch (const std::runtime_error&) {
+      return std::nullopt;
+    }
+  };
+
+  if (def.arcade.intro && def.arcade.ending) {
+    auto ending = std::async(std::launch::async, follow, std::cref(def.arcade.ending));
+    def.arcade.introStoryboard = follow(def.arcade.intro);
+    def.arcade.endingStoryboard = ending.get();
+  } else {
+    def.arcade.introStoryboard = follow(def.arcade.intro);
+    def.arcade.endingStoryboard = follow(def.arcade.ending);
+  }
+
+  return def;
+}
+
+MDEFPARSER_INLINE std::vector<mugen::def::BatchResult<mugen::def::MugenDefWin>> mugen::def::parse_batch(
+    mugen::def::DefParserWin& parser,
+    std::span<const std::filesystem::path> paths,
+    unsigned jobs) {
+  std::vector<mugen::def::BatchResult<mugen::def::MugenDefWin>> results(paths.size());
+  mugen::def::internal::parallel_for(paths.size(), jobs, [&](std::size_t i) {
+    results[i] = mugen::def::internal::capture_result<mugen::def::MugenDefWin>([&]() { return parser.parse(paths[i]); });
+  });
+  return results;
+}
+
+MDEFPARSER_INLINE void mugen::def::parse_batch(
+    mugen::def::DefParserWin& parser,
+    std::span<const std::filesystem::path> paths,
+    const std::function<void(std::size_t, mugen::def::BatchResult<mugen::def::MugenDefWin>&&)>& callback,
+    unsigned jobs) {
+  mugen::def::internal::parallel_for(paths.size(), jobs, [&](std::size_t i) {
+    callback(i, mugen::def::internal::capture_result<mugen::def::MugenDefWin>([&]() { return parser.parse(paths[i]); }));
+  });
+}
@@ -0,0 +1,70 @@
+/**
+ * @file binary.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_IMPL_BINARY_HPP__
+#define MDEFPARSER_IMPL_BINARY_HPP__
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+template <class T>
+static inline T load_le(const void* src) noexcept {
+  static_assert(std::is_integral_v<T>);
+
+  T value;
+  std::memcpy(&value, src, sizeof(T));
+  if constexpr (std::endian::native == std::endian::big) {
+    auto bytes = static_cast<const unsigned char*>(src);
+    std::make_unsigned_t<T> swapped = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      swapped |= static_cast<std::make_unsigned_t<T>>(bytes[i]) << (8 * i);
+    }
+    value = static_cast<T>(swapped);
+  }
+  return value;
+}
+
+template <class T>
+static inline void store_le(void* dest, T value) noexcept {
+  static_assert(std::is_integral_v<T>);
+
+  if constexpr (std::endian::native == std::endian::big) {
+    auto bytes = static_cast<unsigned char*>(dest);
+    auto raw = static_cast<std::make_unsigned_t<T>>(value);
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      bytes[i] = static_cast<unsigned char>(raw >> (8 * i));
+    }
+  } else {
+    std::memcpy(dest, &value, sizeof(T));
+  }
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_IMPL_BINARY_HPP__
@@ -0,0 +1,158 @@
+/**
+ * @file cache.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/cache.hpp"
+#include "mdefparser/impl/file.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <utility>
+
+MDEFPARSER_INLINE mugen::def::CachingDefParser::CachingDefParser(std::size_t capacity, std::size_t shardCount, const mugen::def::ParseLimits& limits)
+    : parser_{limits}, shards_{}, shardCapacity_{0}, generation_{0}, hits_{0}, misses_{0}, evictions_{0} {
+  shardCount = std::max<std::size_t>(shardCount, 1);
+  shardCapacity_ = std::max<std::size_t>((capacity + shardCount - 1) / shardCount, 1);
+
+  shards_.reserve(shardCount);
+  for (std::size_t i = 0; i < shardCount; ++i) {
+    shards_.push_back(std::make_unique<Shard>());
+  }
+}
+
+MDEFPARSER_INLINE std::shared_ptr<const mugen::def::MugenDefWin> mugen::def::CachingDefParser::parse(const std::filesystem::path& path) {
+  auto stamp = mugen::def::internal::stat_file(path);
+  if (!stamp) {
+    // 存在しないファイルなどはパーサーに例外を投げさせる
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return std::make_shared<const mugen::def::MugenDefWin>(parser_.parse(path));
+  }
+
+  // "a/kfm.def" と "./a/kfm.def" を同じものとして扱う (string() は Windows で ACP に変換できないと例外を投げる)
+  auto key = path.lexically_normal().native();
+  auto& shard = shard_for(key);
+
+  std::promise<std::shared_ptr<const mugen::def::MugenDefWin>> promise{};
+  std::uint64_t generation = 0;
+  {
+    std::unique_lock lock{shard.mutex};
+    auto it = shard.nodes.find(key);
+    if (it != shard.nodes.end()) {
+      auto& node = it->second;
+      if (node.size == stamp->size && node.modified == stamp->modified) {
+        shard.lru.splice(shard.lru.begin(), shard.lru, node.lru);
+        auto result = node.result;
+        lock.unlock();
+
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return result.get();
+      }
+
+      // 更新されたファイルは読み込み直す
+      shard.lru.erase(node.lru);
+      shard.nodes.erase(it);
+    }
+
+    generation = generation_.fetch_add(1, std::memory_order_relaxed);
+    shard.lru.push_front(key);
+    shard.nodes.emplace(key, Node{.size = stamp->size,
+                                  .modified = stamp->modified,
+                                  .generation = generation,
+                                  .result = promise.get_future().share(),
+                                  .lru = shard.lru.begin()});
+
+    while (shard.nodes.size() > shardCapacity_) {
+      // 待っている要求は shared_future を持っているので、パース中のものを取り除いてもよい
+      shard.nodes.erase(shard.lru.back());
+      shard.lru.pop_back();
+      evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  try {
+    auto def = std::make_shared<const mugen::def::MugenDefWin>(parser_.parse(path));
+    promise.set_value(def);
+    return def;
+  } catch (...) {
+    promise.set_exception(std::current_exception());
+    erase_if_generation(shard, key, generation);
+    throw;
+  }
+}
+
+MDEFPARSER_INLINE void mugen::def::CachingDefParser::invalidate(const std::filesystem::path& path) {
+  auto key = path.lexically_normal().native();
+  auto& shard = shard_for(key);
+
+  std::lock_guard lock{shard.mutex};
+  auto it = shard.nodes.find(key);
+  if (it != shard.nodes.end()) {
+    shard.lru.erase(it->second.lru);
+    shard.nodes.erase(it);
+  }
+}
+
+MDEFPARSER_INLINE void mugen::def::CachingDefParser::clear() {
+  for (auto& shard : shards_) {
+    std::lock_guard lock{shard->mutex};
+    shard->nodes.clear();
+    shard->lru.clear();
+  }
+}
+
+MDEFPARSER_INLINE mugen::def::CacheStats mugen::def::CachingDefParser::stats() const {
+  std::size_t size = 0;
+  for (const auto& shard : shards_) {
+    std::lock_guard lock{shard->mutex};
+    size += shard->nodes.size();
+  }
+
+  return mugen::def::CacheStats{.hits = hits_.load(std::memory_order_relaxed),
+                                .misses = misses_.load(std::memory_order_relaxed),
+                                .evictions = evictions_.load(std::memory_order_relaxed),
+                                .size = size};
+}
+
+MDEFPARSER_INLINE mugen::def::CachingDefParser::Shard& mugen::def::CachingDefParser::shard_for(
+    const std::filesystem::path::string_type& key) noexcept {
+  return *shards_[std::hash<std::filesystem::path::string_type>{}(key) % shards_.size()];
+}
+
+MDEFPARSER_INLINE void mugen::def::CachingDefParser::erase_if_generation(Shard& shard,
+                                                                         const std::filesystem::path::string_type& key,
+                                                                         std::uint64_t generation) {
+  // 失敗している間に別の要求が入れ直したものは残す
+  std::lock_guard lock{shard.mutex};
+  auto it = shard.nodes.find(key);
+  if (it != shard.nodes.end() && it->second.generation == generation) {
+    shard.lru.erase(it->second.lru);
+    shard.nodes.erase(it);
+  }
+}
@@ -0,0 +1,227 @@
+/**
+ * @file catalog.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/catalog.hpp"
+#include "mdefparser/impl/parallel.hpp"
+#include "mdefparser/impl/path.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+using CatalogRecord = std::pair<std::string, std::uint32_t>;
+
+// CP932 の 2 バイト文字 (ア = 0x83 0x41 など) は小文字にしない
+static inline std::string catalog_key(std::string_view value) {
+  return mugen::def::internal::fold_ascii(value);
+}
+
+static inline std::string catalog_path_key(std::string_view base, const std::filesystem::path& file) {
+  return mugen::def::internal::fold_ascii(mugen::def::internal::join_generic_path(base, mugen::def::internal::to_generic_path(file)));
+}
+
+// AsciiFolder で小文字にしたものを unsigned char として比較する
+static inline bool catalog_key_less(mugen::def::internal::AsciiFolder a, mugen::def::internal::AsciiFolder b) noexcept {
+  while (!a.done() && !b.done()) {
+    auto x = static_cast<unsigned char>(a.next());
+    auto y = static_cast<unsigned char>(b.next());
+    if (x != y) {
+      return x < y;
+    }
+  }
+  return a.done() && !b.done();
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE mugen::def::DefCatalog::DefCatalog() noexcept : entries_{}, fieldIndexes_{}, fileIndex_{} {}
+
+MDEFPARSER_INLINE mugen::def::DefCatalog::DefCatalog(std::vector<mugen::def::CatalogEntry> entries, unsigned jobs)
+    : entries_{std::move(entries)}, fieldIndexes_{}, fileIndex_{} {
+  if (entries_.size() >= std::numeric_limits<std::uint32_t>::max()) {
+    throw mugen::def::LimitExceededError{"Too many catalog entries."};
+  }
+
+  auto collect = [this](std::size_t target) {
+    std::vector<mugen::def::internal::CatalogRecord> records{};
+    records.reserve(target < fieldIndexes_.size() ? entries_.size() : entries_.size() * 16);
+
+    for (std::uint32_t id = 0; id < entries_.size(); ++id) {
+      const auto& entry = entries_[id];
+      if (target == static_cast<std::size_t>(mugen::def::CatalogField::Name)) {
+        records.emplace_back(mugen::def::internal::catalog_key(entry.def.info.name), id);
+      } else if (target == static_cast<std::size_t>(mugen::def::CatalogField::DisplayName)) {
+        if (entry.def.info.displayName) {
+          records.emplace_back(mugen::def::internal::catalog_key(*entry.def.info.displayName), id);
+        }
+      } else if (target == static_cast<std::size_t>(mugen::def::CatalogField::Author)) {
+        if (entry.def.info.author) {
+          records.emplace_back(mugen::def::internal::catalog_key(*entry.def.info.author), id);
+        }
+      } else {
+        auto base = mugen::def::internal::to_generic_path(entry.path.parent_path());
+        mugen::def::for_each_key([&](auto item) {
+          constexpr auto key = decltype(item)::value;
+          if constexpr (std::is_same_v<typename mugen::def::DefItemType<key>::type, std::filesystem::path>) {
+            // [Arcade] の storyboard は files.* ではないので対象外
+            if constexpr (key != mugen::def::DefParseKey::Intro && key != mugen::def::DefParseKey::Ending) {
+              const auto& value = mugen::def::get_item<key>(entry.def);
+              if constexpr (mugen::def::is_required_item<key>) {
+                records.emplace_back(mugen::def::internal::catalog_path_key(base, value), id);
+              } else {
+                if (value && !value->empty()) {
+                  records.emplace_back(mugen::def::internal::catalog_path_key(base, *value), id);
+                }
+              }
+            }
+          }
+        });
+      }
+    }
+
+    if (target < fieldIndexes_.size()) {
+      std::sort(records.begin(), records.end());
+    } else {
+      // ファイルは完全一致でしか引かないので、比較の軽いハッシュ値の順に並べて同じキーをまとめる
+      std::vector<std::pair<std::size_t, std::uint32_t>> order(records.size());
+      for (std::uint32_t i = 0; i < records.size(); ++i) {
+        order[i] = {std::hash<std::string_view>{}(records[i].first), i};
+      }
+      std::sort(order.begin(), order.end(), [&records](const auto& a, const auto& b) {
+        if (a.first != b.first) {
+          return a.first < b.first;
+        }
+        return records[a.second] < records[b.second];
+      });
+
+      std::vector<mugen::def::internal::CatalogRecord> sorted{};
+      sorted.reserve(records.size());
+      for (auto [hash, i] : order) {
+        sorted.push_back(std::move(records[i]));
+      }
+      records = std::move(sorted);
+    }
+    records.erase(std::unique(records.begin(), records.end()), records.end());
+
+    auto& index = target < fieldIndexes_.size() ? fieldIndexes_[target] : fileIndex_;
+    index.keys.reserve(records.size());
+    index.ids.reserve(records.size());
+    for (auto& [key, id] : records) {
+      index.keys.push_back(std::move(key));
+      index.ids.push_back(id);
+    }
+
+    // keys の並びが確定してから各要素を指す string_view を作る
+    index.exact.reserve(index.keys.size());
+    for (std::uint32_t first = 0; first < index.keys.size();) {
+      auto last = first + 1;
+      while (last < index.keys.size() && index.keys[last] == index.keys[first]) {
+        ++last;
+      }
+      index.exact.emplace(index.keys[first], std::make_pair(first, last));
+      first = last;
+    }
+  };
+
+  mugen::def::internal::parallel_for(fieldIndexes_.size() + 1, jobs, collect);
+}
+
+MDEFPARSER_INLINE std::size_t mugen::def::DefCatalog::KeyHash::operator()(std::string_view key) const noexcept {
+  // FNV-1a
+  std::uint64_t hash = 0xcbf29ce484222325;
+  for (mugen::def::internal::AsciiFolder folder{key}; !folder.done();) {
+    hash = (hash ^ static_cast<unsigned char>(folder.next())) * 0x100000001b3;
+  }
+  return static_cast<std::size_t>(hash);
+}
+
+MDEFPARSER_INLINE bool mugen::def::DefCatalog::KeyEqual::operator()(std::string_view a, std::string_view b) const noexcept {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  mugen::def::internal::AsciiFolder x{a};
+  mugen::def::internal::AsciiFolder y{b};
+  while (!x.done()) {
+    if (x.next() != y.next()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+MDEFPARSER_INLINE std::span<const std::uint32_t> mugen::def::DefCatalog::find(mugen::def::CatalogField field, std::string_view value) const {
+  return find_exact(fieldIndexes_[static_cast<std::size_t>(field)], value);
+}
+
+MDEFPARSER_INLINE std::span<const std::uint32_t> mugen::def::DefCatalog::find_prefix(mugen::def::CatalogField field,
+                                                                                    std::string_view prefix) const {
+  const auto& index = fieldIndexes_[static_cast<std::size_t>(field)];
+
+  // prefix を 1 文字ずつ小文字にして比較する (std::string と同じく unsigned char として比較する)
+  // prefix は末尾で文字が途切れていても UTF-8 とみなせるようにする
+  auto utf8 = mugen::def::internal::is_valid_utf8(prefix, true);
+  auto first = std::lower_bound(index.keys.begin(), index.keys.end(), prefix, [utf8](const std::string& key, std::string_view value) {
+    return mugen::def::internal::catalog_key_less(mugen::def::internal::AsciiFolder{key}, mugen::def::internal::AsciiFolder{value, utf8});
+  });
+  auto last = std::partition_point(first, index.keys.end(), [prefix, utf8](const std::string& key) {
+    if (key.size() < prefix.size()) {
+      return false;
+    }
+    mugen::def::internal::AsciiFolder x{key};
+    mugen::def::internal::AsciiFolder y{prefix, utf8};
+    while (!y.done()) {
+      if (x.next() != y.next()) {
+        return false;
+      }
+    }
+    return true;
+  });
+  return std::span<const std::uint32_t>{index.ids}.subspan(static_cast<std::size_t>(first - index.keys.begin()),
+                                                            static_cast<std::size_t>(last - first));
+}
+
+MDEFPARSER_INLINE std::span<const std::uint32_t> mugen::def::DefCatalog::find_file(const std::filesystem::path& file) const {
+  return find_exact(fileIndex_, mugen::def::internal::catalog_path_key(std::string_view{}, file));
+}
+
+MDEFPARSER_INLINE std::span<const std::uint32_t> mugen::def::DefCatalog::find_exact(const Index& index, std::string_view key) const {
+  auto it = index.exact.find(key);
+  if (it == index.exact.end()) {
+    return {};
+  }
+  auto [first, last] = it->second;
+  return std::span<const std::uint32_t>{index.ids}.subspan(first, last - first);
+}
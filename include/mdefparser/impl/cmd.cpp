@@ -0,0 +1,147 @@
+/**
+ * @file cmd.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/cmd.hpp"
+#include "mdefparser/impl/file.hpp"
+#include "mdefparser/impl/line_reader.hpp"
+#include "mdefparser/impl/tokenizer.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+using namespace std::string_view_literals;
+
+enum class CmdSection {
+  Other,
+  Command,
+  StateController,
+};
+
+// "State -1, label" から label を取り出す (State -1 以外は std::nullopt)
+static inline std::optional<std::string_view> parse_cmd_state_label(std::string_view name) noexcept {
+  if (!mugen::def::internal::istarts_with(name, "state"sv)) {
+    return std::nullopt;
+  }
+
+  name.remove_prefix("state"sv.size());
+  size_t comma = name.find(',');
+  if (mugen::def::internal::parse_number<std::int32_t>(name.substr(0, comma)) != -1) {
+    return std::nullopt;
+  }
+  return comma == std::string_view::npos ? std::string_view{} : mugen::def::internal::trim_view(name.substr(comma + 1));
+}
+
+static inline std::string_view dequote_cmd_name(std::string_view value) noexcept {
+  if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+    return value.substr(1, value.size() - 2);
+  }
+  return value;
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE std::span<const mugen::def::CmdCommand> mugen::def::CmdIndex::find(std::string_view name) const noexcept {
+  auto first = std::partition_point(commands.begin(), commands.end(), [name](const mugen::def::CmdCommand& command) { return command.name < name; });
+  auto last = std::partition_point(first, commands.end(), [name](const mugen::def::CmdCommand& command) { return command.name == name; });
+  return std::span<const mugen::def::CmdCommand>{commands.data() + (first - commands.begin()), static_cast<size_t>(last - first)};
+}
+
+MDEFPARSER_INLINE mugen::def::CmdReader::CmdReader() noexcept {}
+
+MDEFPARSER_INLINE mugen::def::CmdIndex mugen::def::CmdReader::read_index(const std::filesystem::path& path) {
+  mugen::def::internal::ReadOnlyFile file{path};
+  mugen::def::internal::LineReader reader{file};
+
+  mugen::def::CmdIndex index{};
+  auto section = mugen::def::internal::CmdSection::Other;
+  // 現在の [Command] の範囲 (name = はセクションの途中にあるため、セクションの終わりで確定する)
+  std::optional<std::string> commandName{};
+  mugen::def::CmdRange commandRange{};
+
+  auto close_section = [&](std::uint64_t end, std::uint32_t endLine) {
+    if (section == mugen::def::internal::CmdSection::Command) {
+      commandRange.end = end;
+      commandRange.endLine = endLine;
+      // name = のない [Command] は MUGEN でも無視される
+      if (commandName) {
+        index.commands.push_back(mugen::def::CmdCommand{.name = std::move(*commandName), .range = commandRange});
+      }
+    } else if (section == mugen::def::internal::CmdSection::StateController) {
+      index.stateControllers.back().range.end = end;
+      index.stateControllers.back().range.endLine = endLine;
+    }
+    section = mugen::def::internal::CmdSection::Other;
+  };
+
+  std::uint32_t lineNumber = 0;
+  std::string_view line;
+  while (reader.next(line)) {
+    ++lineNumber;
+    line = mugen::def::internal::trim_view(line);
+    if (line.empty()) {
+      continue;
+    }
+
+    if (line.front() == '[') {
+      close_section(reader.line_offset(), lineNumber);
+
+      auto name = mugen::def::internal::section_name(line).value_or(std::string_view{});
+      mugen::def::CmdRange range{.begin = reader.line_offset(), .end = 0, .beginLine = lineNumber, .endLine = 0};
+      if (mugen::def::internal::iequals(name, "command"sv)) {
+        section = mugen::def::internal::CmdSection::Command;
+        commandName.reset();
+        commandRange = range;
+      } else if (auto label = mugen::def::internal::parse_cmd_state_label(name)) {
+        section = mugen::def::internal::CmdSection::StateController;
+        index.stateControllers.push_back(mugen::def::CmdStateController{.label = std::string{*label}, .range = range});
+      }
+      continue;
+    }
+
+    // [Command] 内は name = のみを見る
+    if (section == mugen::def::internal::CmdSection::Command && !commandName) {
+      auto kv = mugen::def::internal::split_key_value(line);
+      if (kv && mugen::def::internal::iequals((*kv)[0], "name"sv)) {
+        commandName = std::string{mugen::def::internal::dequote_cmd_name((*kv)[1])};
+      }
+    }
+  }
+  close_section(file.size(), lineNumber + 1);
+
+  std::stable_sort(index.commands.begin(), index.commands.end(),
+                   [](const mugen::def::CmdCommand& a, const mugen::def::CmdCommand& b) { return a.name < b.name; });
+  return index;
+}
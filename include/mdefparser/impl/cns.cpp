@@ -0,0 +1,152 @@
+/**
+ * @file cns.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/cns.hpp"
+#include "mdefparser/impl/file.hpp"
+#include "mdefparser/impl/line_reader.hpp"
+#include "mdefparser/impl/parallel.hpp"
+#include "mdefparser/impl/tokenizer.hpp"
+
+#include <array>
+#include <bitset>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+using namespace std::string_view_literals;
+
+static inline constexpr std::array<std::string_view, 4> CNS_CONSTANT_SECTIONS = {"data"sv, "size"sv, "velocity"sv, "movement"sv};
+
+// 定数は通常ファイルの先頭数 KB に収まるため、小さい単位で読み込んで読み過ぎを抑える
+static inline constexpr std::size_t CNS_CHUNK_SIZE = 0x4000;
+
+static inline std::optional<std::size_t> find_cns_section(std::string_view name) noexcept {
+  for (std::size_t i = 0; i < mugen::def::internal::CNS_CONSTANT_SECTIONS.size(); ++i) {
+    if (mugen::def::internal::iequals(name, mugen::def::internal::CNS_CONSTANT_SECTIONS[i])) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE const std::string* mugen::def::CnsConstants::find(std::string_view section, std::string_view key) const noexcept {
+  for (const auto& constant : values) {
+    if (mugen::def::internal::iequals(constant.section, section) && mugen::def::internal::iequals(constant.key, key)) {
+      return &constant.value;
+    }
+  }
+  return nullptr;
+}
+
+MDEFPARSER_INLINE std::optional<double> mugen::def::CnsConstants::number(std::string_view section,
+                                                                         std::string_view key,
+                                                                         std::size_t index) const noexcept {
+  const auto* value = find(section, key);
+  if (!value) {
+    return std::nullopt;
+  }
+
+  std::string_view rest{*value};
+  for (std::size_t i = 0; i < index; ++i) {
+    size_t delim = rest.find(',');
+    if (delim == std::string_view::npos) {
+      return std::nullopt;
+    }
+    rest.remove_prefix(delim + 1);
+  }
+  return mugen::def::internal::parse_number<double>(rest.substr(0, rest.find(',')));
+}
+
+MDEFPARSER_INLINE mugen::def::CnsConstants mugen::def::parse_cns_constants(const std::filesystem::path& path) {
+  mugen::def::internal::ReadOnlyFile file{path};
+  mugen::def::internal::LineReader reader{file, mugen::def::internal::CNS_CHUNK_SIZE};
+
+  mugen::def::CnsConstants constants{};
+  std::bitset<mugen::def::internal::CNS_CONSTANT_SECTIONS.size()> seen{};
+  std::optional<std::size_t> section{};
+
+  std::string_view line;
+  while (reader.next(line)) {
+    line = mugen::def::internal::trim_view(line);
+    if (line.empty()) {
+      continue;
+    }
+
+    if (line.front() == '[') {
+      auto name = mugen::def::internal::section_name(line).value_or(std::string_view{});
+      // ステート定義以降に定数のセクションは現れない
+      if (seen.all() || mugen::def::internal::istarts_with(name, "statedef"sv)) {
+        break;
+      }
+      section = mugen::def::internal::find_cns_section(name);
+      if (section) {
+        seen.set(*section);
+      }
+      continue;
+    }
+
+    if (section) {
+      auto kv = mugen::def::internal::split_key_value(line);
+      if (kv && !(*kv)[0].empty()) {
+        std::string key{(*kv)[0]};
+        mugen::def::internal::tolowers(key);
+        constants.values.push_back(mugen::def::CnsConstant{
+            .section = std::string{mugen::def::internal::CNS_CONSTANT_SECTIONS[*section]}, .key = std::move(key), .value = std::string{(*kv)[1]}});
+      }
+    }
+  }
+
+  return constants;
+}
+
+MDEFPARSER_INLINE std::vector<mugen::def::BatchResult<mugen::def::CnsConstants>> mugen::def::parse_cns_constants_batch(
+    std::span<const std::filesystem::path> paths,
+    unsigned jobs) {
+  std::vector<mugen::def::BatchResult<mugen::def::CnsConstants>> results(paths.size());
+  mugen::def::internal::parallel_for(paths.size(), jobs, [&](std::size_t i) {
+    results[i] = mugen::def::internal::capture_result<mugen::def::CnsConstants>([&]() { return mugen::def::parse_cns_constants(paths[i]); });
+  });
+  return results;
+}
+
+MDEFPARSER_INLINE std::vector<mugen::def::BatchResult<mugen::def::CnsConstants>> mugen::def::parse_cns_constants_batch(
+    std::span<const mugen::def::CatalogEntry> entries,
+    unsigned jobs) {
+  std::vector<std::filesystem::path> paths{};
+  paths.reserve(entries.size());
+  for (const auto& entry : entries) {
+    paths.push_back(mugen::def::internal::resolve_def_path(entry.path.parent_path(), entry.def.files.cns));
+  }
+  return mugen::def::parse_cns_constants_batch(paths, jobs);
+}
@@ -0,0 +1,150 @@
+/**
+ * @file columnar.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/columnar.hpp"
+
+#include <optional>
+#include <stdexcept>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+template <class Column, class T>
+static inline void append_column_value(Column& column, const T* value) {
+  column.presence.push_back(value != nullptr);
+
+  if constexpr (std::is_same_v<Column, mugen::def::VersionColumn>) {
+    column.months.push_back(value ? value->month : 0);
+    column.days.push_back(value ? value->day : 0);
+    column.years.push_back(value ? value->year : 0);
+  } else if constexpr (std::is_same_v<Column, mugen::def::PalDefaultsColumn>) {
+    if (value) {
+      column.values.insert(column.values.end(), value->begin(), value->end());
+    }
+    column.offsets.push_back(static_cast<std::uint32_t>(column.values.size()));
+  } else {
+    if (value) {
+      if constexpr (std::is_same_v<T, std::filesystem::path>) {
+        auto u8 = value->u8string();
+        column.blob.append(reinterpret_cast<const char*>(u8.data()), u8.size());
+      } else {
+        column.blob.append(*value);
+      }
+    }
+    column.offsets.push_back(column.blob.size());
+  }
+}
+
+template <class T, class Column>
+static inline T read_column_value(const Column& column, std::size_t index) {
+  if constexpr (std::is_same_v<Column, mugen::def::VersionColumn>) {
+    return T{.month = column.months[index], .day = column.days[index], .year = column.years[index]};
+  } else if constexpr (std::is_same_v<Column, mugen::def::PalDefaultsColumn>) {
+    auto values = column.view(index);
+    return T(values.begin(), values.end());
+  } else if constexpr (std::is_same_v<T, std::filesystem::path>) {
+    auto value = column.view(index);
+    return std::filesystem::path{std::u8string_view{reinterpret_cast<const char8_t*>(value.data()), value.size()}};
+  } else {
+    return T{column.view(index)};
+  }
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE mugen::def::ColumnarCatalog::ColumnarCatalog() noexcept
+    : size_{0}, strings_{}, versionDate_{}, mugenVersion_{}, palDefaults_{} {}
+
+MDEFPARSER_INLINE mugen::def::ColumnarCatalog::ColumnarCatalog(std::span<const mugen::def::MugenDefWin> defs) : ColumnarCatalog{} {
+  reserve(defs.size());
+  for (const auto& def : defs) {
+    append(def);
+  }
+}
+
+MDEFPARSER_INLINE void mugen::def::ColumnarCatalog::reserve(std::size_t rows) {
+  mugen::def::for_each_key([&](auto item) {
+    constexpr auto key = decltype(item)::value;
+    auto& column = mutable_column<key>();
+    column.presence.reserve(rows);
+
+    if constexpr (std::is_same_v<mugen::def::ColumnType<key>, mugen::def::VersionColumn>) {
+      column.months.reserve(rows);
+      column.days.reserve(rows);
+      column.years.reserve(rows);
+    } else {
+      column.offsets.reserve(rows + 1);
+    }
+  });
+}
+
+MDEFPARSER_INLINE void mugen::def::ColumnarCatalog::append(const mugen::def::MugenDefWin& def) {
+  mugen::def::for_each_key([&](auto item) {
+    constexpr auto key = decltype(item)::value;
+    const auto& value = mugen::def::get_item<key>(def);
+
+    if constexpr (mugen::def::is_required_item<key>) {
+      mugen::def::internal::append_column_value(mutable_column<key>(), &value);
+    } else {
+      mugen::def::internal::append_column_value(mutable_column<key>(), value ? &*value : nullptr);
+    }
+  });
+  ++size_;
+}
+
+MDEFPARSER_INLINE mugen::def::MugenDefWin mugen::def::ColumnarCatalog::row(std::size_t index) const {
+  if (index >= size_) {
+    throw std::out_of_range{"Row index is out of range."};
+  }
+
+  mugen::def::MugenDefWin def{};
+  mugen::def::for_each_key([&](auto item) {
+    constexpr auto key = decltype(item)::value;
+    using Type = typename mugen::def::DefItemType<key>::type;
+    const auto& column = this->column<key>();
+
+    if (column.presence.test(index)) {
+      mugen::def::get_item<key>(def) = mugen::def::internal::read_column_value<Type>(column, index);
+    }
+  });
+  return def;
+}
+
+MDEFPARSER_INLINE const mugen::def::PresenceBitmap& mugen::def::ColumnarCatalog::presence(mugen::def::DefParseKey key) const noexcept {
+  const mugen::def::PresenceBitmap* presence = nullptr;
+  mugen::def::for_each_key([&](auto item) {
+    if (item.value == key) {
+      presence = &column<item.value>().presence;
+    }
+  });
+  return *presence;
+}
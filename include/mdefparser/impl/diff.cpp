@@ -0,0 +1,150 @@
+/**
+ * @file diff.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/diff.hpp"
+#include "mdefparser/fingerprint.hpp"
+#include "mdefparser/serialize.hpp"
+#include "mdefparser/impl/parallel.hpp"
+#include "mdefparser/impl/path.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <tuple>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+struct DiffRecord {
+  std::string path;
+  std::uint64_t hash;
+  std::size_t index;
+
+  bool operator<(const DiffRecord& other) const noexcept {
+    return std::tie(path, index) < std::tie(other.path, other.index);
+  }
+};
+
+static inline std::vector<mugen::def::internal::DiffRecord> diff_records(std::span<const mugen::def::CatalogEntry> entries, unsigned jobs) {
+  std::vector<mugen::def::internal::DiffRecord> records(entries.size());
+  mugen::def::internal::parallel_for(entries.size(), jobs, [&](std::size_t i) {
+    // シリアライズした内容のハッシュ値を内容の代わりに比較する
+    thread_local std::vector<std::byte> buffer{};
+    buffer.resize(mugen::def::serialized_size(entries[i].def));
+    mugen::def::serialize(entries[i].def, buffer);
+
+    records[i] = mugen::def::internal::DiffRecord{
+        .path = mugen::def::internal::to_generic_path(entries[i].path), .hash = mugen::def::xxh64(buffer), .index = i};
+  });
+  return records;
+}
+
+template <class T>
+static inline bool item_equals(const T& a, const T& b) noexcept {
+  return a == b;
+}
+
+static inline bool item_equals(const mugen::def::MugenDefVersion& a, const mugen::def::MugenDefVersion& b) noexcept {
+  return a.month == b.month && a.day == b.day && a.year == b.year;
+}
+
+static inline bool item_equals(const mugen::def::StoryboardDef& a, const mugen::def::StoryboardDef& b) noexcept {
+  return a.sprite == b.sprite && a.sound == b.sound && a.sceneCount == b.sceneCount;
+}
+
+template <class T>
+static inline bool item_equals(const std::optional<T>& a, const std::optional<T>& b) noexcept {
+  if (!a || !b) {
+    return !a && !b;
+  }
+  return mugen::def::internal::item_equals(*a, *b);
+}
+
+static inline mugen::def::DefKeySet changed_keys(const mugen::def::MugenDefWin& before, const mugen::def::MugenDefWin& after) noexcept {
+  mugen::def::DefKeySet keys{};
+  mugen::def::for_each_key([&](auto key) {
+    if (!mugen::def::internal::item_equals(mugen::def::get_item<key.value>(before), mugen::def::get_item<key.value>(after))) {
+      keys.set(static_cast<std::size_t>(key.value));
+    }
+  });
+
+  if (!mugen::def::internal::item_equals(before.arcade.introStoryboard, after.arcade.introStoryboard)) {
+    keys.set(static_cast<std::size_t>(mugen::def::DefParseKey::Intro));
+  }
+  if (!mugen::def::internal::item_equals(before.arcade.endingStoryboard, after.arcade.endingStoryboard)) {
+    keys.set(static_cast<std::size_t>(mugen::def::DefParseKey::Ending));
+  }
+  return keys;
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE std::vector<mugen::def::CatalogDiff> mugen::def::diff_catalogs(std::span<const mugen::def::CatalogEntry> before,
+                                                                                 std::span<const mugen::def::CatalogEntry> after,
+                                                                                 unsigned jobs) {
+  auto beforeRecords = mugen::def::internal::diff_records(before, jobs);
+  auto afterRecords = mugen::def::internal::diff_records(after, jobs);
+  mugen::def::internal::parallel_for(2, jobs, [&](std::size_t side) {
+    auto& records = side == 0 ? beforeRecords : afterRecords;
+    std::sort(records.begin(), records.end());
+  });
+
+  constexpr auto npos = mugen::def::CatalogDiff::npos;
+  std::vector<mugen::def::CatalogDiff> diffs{};
+  std::vector<std::size_t> changed{};
+
+  auto b = beforeRecords.begin();
+  auto a = afterRecords.begin();
+  while (b != beforeRecords.end() || a != afterRecords.end()) {
+    if (a == afterRecords.end() || (b != beforeRecords.end() && b->path < a->path)) {
+      diffs.push_back(mugen::def::CatalogDiff{.kind = mugen::def::DiffKind::Removed, .before = b->index, .after = npos, .changedKeys = {}});
+      ++b;
+    } else if (b == beforeRecords.end() || a->path < b->path) {
+      diffs.push_back(mugen::def::CatalogDiff{.kind = mugen::def::DiffKind::Added, .before = npos, .after = a->index, .changedKeys = {}});
+      ++a;
+    } else {
+      if (b->hash != a->hash) {
+        changed.push_back(diffs.size());
+        diffs.push_back(mugen::def::CatalogDiff{.kind = mugen::def::DiffKind::Changed, .before = b->index, .after = a->index, .changedKeys = {}});
+      }
+      ++b;
+      ++a;
+    }
+  }
+
+  // 変更された項目はハッシュ値が異なったものについてのみ調べる
+  mugen::def::internal::parallel_for(changed.size(), jobs, [&](std::size_t i) {
+    auto& diff = diffs[changed[i]];
+    diff.changedKeys = mugen::def::internal::changed_keys(before[diff.before].def, after[diff.after].def);
+  });
+  return diffs;
+}
@@ -0,0 +1,183 @@
+/**
+ * @file file.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_IMPL_FILE_HPP__
+#define MDEFPARSER_IMPL_FILE_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/impl/portable_file.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+// 位置指定読み込み (pread / ReadFile + OVERLAPPED) のみを行う読み取り専用ファイル
+class ReadOnlyFile {
+ public:
+  ReadOnlyFile(const ReadOnlyFile&) = delete;
+  ReadOnlyFile& operator=(const ReadOnlyFile&) = delete;
+
+  explicit ReadOnlyFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+    handle_ = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle_ == INVALID_HANDLE_VALUE) {
+      throw mugen::def::FileIOError{"Can't open the specified file."};
+    }
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(handle_, &size)) {
+      ::CloseHandle(handle_);
+      throw mugen::def::FileIOError{"Can't get the size of the specified file."};
+    }
+    size_ = static_cast<std::uint64_t>(size.QuadPart);
+#else
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+      throw mugen::def::FileIOError{"Can't open the specified file."};
+    }
+
+    struct stat st;
+    if (::fstat(fd_, &st) != 0 || !S_ISREG(st.st_mode)) {
+      ::close(fd_);
+      throw mugen::def::FileIOError{"Can't find the specified file."};
+    }
+    size_ = static_cast<std::uint64_t>(st.st_size);
+#endif
+  }
+
+  ~ReadOnlyFile() {
+#ifdef _WIN32
+    ::CloseHandle(handle_);
+#else
+    ::close(fd_);
+#endif
+  }
+
+  std::uint64_t size() const noexcept {
+    return size_;
+  }
+
+  // 読み込めたバイト数を返す (EOF に達した場合は length 未満)
+  std::size_t read_at(std::uint64_t offset, void* buffer, std::size_t length) const {
+    auto* dest = static_cast<char*>(buffer);
+    std::size_t total = 0;
+    while (total < length) {
+#ifdef _WIN32
+      OVERLAPPED overlapped{};
+      std::uint64_t position = offset + total;
+      overlapped.Offset = static_cast<DWORD>(position);
+      overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+
+      DWORD request = static_cast<DWORD>(std::min<std::size_t>(length - total, 0x40000000));
+      DWORD read = 0;
+      if (!::ReadFile(handle_, dest + total, request, &read, &overlapped)) {
+        if (::GetLastError() == ERROR_HANDLE_EOF) {
+          break;
+        }
+        throw mugen::def::FileIOError{"Can't read the specified file."};
+      }
+#else
+      ssize_t read = ::pread(fd_, dest + total, length - total, static_cast<off_t>(offset + total));
+      if (read < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw mugen::def::FileIOError{"Can't read the specified file."};
+      }
+#endif
+      if (read == 0) {
+        break;
+      }
+      total += static_cast<std::size_t>(read);
+    }
+    return total;
+  }
+
+ private:
+#ifdef _WIN32
+  HANDLE handle_;
+#else
+  int fd_;
+#endif
+  std::uint64_t size_;
+};
+
+// キャッシュの有効性の確認に使うファイルのサイズと更新日時
+struct FileStamp {
+  std::uint64_t size;
+  std::int64_t modified;
+
+  bool operator==(const FileStamp&) const = default;
+};
+
+// 通常のファイルでない場合や存在しない場合は std::nullopt
+static inline std::optional<FileStamp> stat_file(const std::filesystem::path& path) noexcept {
+#ifdef _WIN32
+  WIN32_FILE_ATTRIBUTE_DATA data;
+  if (!::GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &data) || (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+    return std::nullopt;
+  }
+  return FileStamp{.size = (static_cast<std::uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow,
+                   .modified = static_cast<std::int64_t>((static_cast<std::uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+                                                         data.ftLastWriteTime.dwLowDateTime)};
+#else
+  struct stat st;
+  if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+    return std::nullopt;
+  }
+#ifdef __APPLE__
+  auto modified = static_cast<std::int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+  auto modified = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+  return FileStamp{.size = static_cast<std::uint64_t>(st.st_size), .modified = modified};
+#endif
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_IMPL_FILE_HPP__
@@ -0,0 +1,215 @@
+/**
+ * @file fingerprint.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/fingerprint.hpp"
+#include "mdefparser/impl/binary.hpp"
+#include "mdefparser/impl/file.hpp"
+#include "mdefparser/impl/parallel.hpp"
+#include "mdefparser/impl/xxhash.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+static inline constexpr std::size_t FINGERPRINT_CHUNK_SIZE = 0x100000;
+static inline constexpr std::uint32_t FINGERPRINT_DEF_SLOT = 0xFFFFFFFF;
+
+template <class File>
+static inline mugen::def::FileDigest digest_contents(const std::filesystem::path& path, const File& file) {
+  mugen::def::internal::Xxh64 hasher{};
+  std::vector<char> buffer(static_cast<std::size_t>(std::clamp<std::uint64_t>(file.size(), 1, FINGERPRINT_CHUNK_SIZE)));
+  std::uint64_t offset = 0;
+  while (offset < file.size()) {
+    auto read = file.read_at(offset, buffer.data(), buffer.size());
+    if (read == 0) {
+      break;
+    }
+    hasher.update(buffer.data(), read);
+    offset += read;
+  }
+
+  return mugen::def::FileDigest{.path = path, .exists = true, .size = offset, .hash = hasher.digest()};
+}
+
+// source が nullptr の場合はファイルを直接読み込む
+static inline mugen::def::FileDigest digest_file(const mugen::def::FileSource* source, const std::filesystem::path& path) {
+  auto missing = mugen::def::FileDigest{.path = path, .exists = false, .size = 0, .hash = 0};
+  if (!source) {
+    std::optional<mugen::def::internal::ReadOnlyFile> file{};
+    try {
+      file.emplace(path);
+    } catch (const mugen::def::FileIOError&) {
+      return missing;
+    }
+    return mugen::def::internal::digest_contents(path, *file);
+  }
+
+  if (!source->stat(path)) {
+    return missing;
+  }
+  auto handle = source->open(path);
+  if (auto data = handle->contiguous()) {
+    return mugen::def::internal::digest_contents(path, mugen::def::internal::MemoryFile{*data});
+  }
+  return mugen::def::internal::digest_contents(path, *handle);
+}
+
+// パッケージのハッシュには各ファイルの (項目, 有無, サイズ, ハッシュ値) を順に与える
+static inline void update_package_hash(mugen::def::internal::Xxh64& hasher, std::uint32_t slot, const mugen::def::FileDigest& digest) noexcept {
+  unsigned char record[21];
+  mugen::def::internal::store_le<std::uint32_t>(record, slot);
+  record[4] = digest.exists ? 1 : 0;
+  mugen::def::internal::store_le<std::uint64_t>(record + 5, digest.size);
+  mugen::def::internal::store_le<std::uint64_t>(record + 13, digest.hash);
+  hasher.update(record, sizeof(record));
+}
+
+static inline mugen::def::PackageFingerprint fingerprint_package(const mugen::def::FileSource* source,
+                                                                 const std::filesystem::path& defPath,
+                                                                 const mugen::def::MugenDefWin& def,
+                                                                 unsigned jobs) {
+  auto base = defPath.parent_path();
+
+  // (項目, files 内の位置) の組。同じファイルを参照する項目は 1 度だけ読み込む
+  std::vector<std::pair<std::uint32_t, std::size_t>> slots{};
+  std::vector<std::filesystem::path> paths{defPath};
+  std::unordered_map<std::filesystem::path::string_type, std::size_t> seen{};
+
+  mugen::def::for_each_key([&](auto item) {
+    constexpr auto key = decltype(item)::value;
+    if constexpr (std::is_same_v<typename mugen::def::DefItemType<key>::type, std::filesystem::path> &&
+                  key != mugen::def::DefParseKey::Intro && key != mugen::def::DefParseKey::Ending) {
+      const auto& value = mugen::def::get_item<key>(def);
+
+      const std::filesystem::path* file = nullptr;
+      if constexpr (mugen::def::is_required_item<key>) {
+        file = &value;
+      } else {
+        file = value ? &*value : nullptr;
+      }
+      if (!file || file->empty()) {
+        return;
+      }
+
+      auto resolved = mugen::def::internal::resolve_def_path(base, *file).lexically_normal();
+      auto [it, inserted] = seen.emplace(resolved.native(), paths.size());
+      if (inserted) {
+        paths.push_back(std::move(resolved));
+      }
+      slots.emplace_back(static_cast<std::uint32_t>(key), it->second);
+    }
+  });
+
+  std::vector<mugen::def::FileDigest> files(paths.size());
+  mugen::def::internal::parallel_for(paths.size(), jobs, [&](std::size_t i) { files[i] = mugen::def::internal::digest_file(source, paths[i]); });
+
+  if (!files[0].exists) {
+    throw mugen::def::FileIOError{"Can't find the specified file."};
+  }
+
+  mugen::def::internal::Xxh64 hasher{};
+  mugen::def::internal::update_package_hash(hasher, mugen::def::internal::FINGERPRINT_DEF_SLOT, files[0]);
+  for (auto [slot, index] : slots) {
+    mugen::def::internal::update_package_hash(hasher, slot, files[index]);
+  }
+
+  return mugen::def::PackageFingerprint{.hash = hasher.digest(), .files = std::move(files)};
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE std::uint64_t mugen::def::xxh64(std::span<const std::byte> data, std::uint64_t seed) noexcept {
+  mugen::def::internal::Xxh64 hasher{seed};
+  hasher.update(data.data(), data.size());
+  return hasher.digest();
+}
+
+MDEFPARSER_INLINE mugen::def::PackageHasher::PackageHasher() noexcept : source_{} {}
+
+MDEFPARSER_INLINE mugen::def::PackageHasher::PackageHasher(std::shared_ptr<const mugen::def::FileSource> source) noexcept
+    : source_{std::move(source)} {}
+
+MDEFPARSER_INLINE mugen::def::PackageFingerprint mugen::def::PackageHasher::fingerprint(const std::filesystem::path& defPath,
+                                                                                        const mugen::def::MugenDefWin& def,
+                                                                                        unsigned jobs) {
+  return mugen::def::internal::fingerprint_package(source_.get(), defPath, def, jobs);
+}
+
+MDEFPARSER_INLINE std::vector<mugen::def::BatchResult<mugen::def::PackageFingerprint>> mugen::def::PackageHasher::fingerprint_batch(
+    std::span<const std::filesystem::path> defPaths,
+    mugen::def::DefParserWin& parser,
+    unsigned jobs) {
+  std::vector<mugen::def::BatchResult<mugen::def::PackageFingerprint>> results(defPaths.size());
+  mugen::def::internal::parallel_for(defPaths.size(), jobs, [&](std::size_t i) {
+    results[i] = mugen::def::internal::capture_result<mugen::def::PackageFingerprint>([&]() {
+      auto def = parser.parse(defPaths[i]);
+      // パッケージ単位で並列化しているので、パッケージ内のファイルは順に読み込む
+      return mugen::def::internal::fingerprint_package(parser.source().get(), defPaths[i], def, 1);
+    });
+  });
+  return results;
+}
+
+MDEFPARSER_INLINE std::vector<std::vector<std::size_t>> mugen::def::group_duplicates(
+    std::span<const mugen::def::BatchResult<mugen::def::PackageFingerprint>> fingerprints) {
+  std::vector<std::pair<std::uint64_t, std::size_t>> order{};
+  order.reserve(fingerprints.size());
+  for (std::size_t i = 0; i < fingerprints.size(); ++i) {
+    if (fingerprints[i]) {
+      order.emplace_back(fingerprints[i].value->hash, i);
+    }
+  }
+  std::sort(order.begin(), order.end());
+
+  std::vector<std::vector<std::size_t>> groups{};
+  for (std::size_t first = 0; first < order.size();) {
+    auto last = first + 1;
+    while (last < order.size() && order[last].first == order[first].first) {
+      ++last;
+    }
+    if (last - first >= 2) {
+      auto& group = groups.emplace_back();
+      for (auto i = first; i < last; ++i) {
+        group.push_back(order[i].second);
+      }
+    }
+    first = last;
+  }
+
+  std::sort(groups.begin(), groups.end());
+  return groups;
+}
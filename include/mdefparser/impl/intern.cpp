@@ -0,0 +1,282 @@
+/**
+ * @file intern.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/intern.hpp"
+#include "mdefparser/async.hpp"
+#include "mdefparser/impl/binary.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+static inline constexpr std::size_t STRING_POOL_CHUNK_SIZE = 0x10000;
+
+// stripe はハッシュの上位ビットで選ぶ
+// 各 stripe の unordered_map は (MSVC のように) 下位ビットでバケットを選ぶことがあり、下位ビットを使うと偏るため
+static inline std::size_t string_pool_stripe(std::size_t hash, unsigned stripeBits) noexcept {
+  return stripeBits == 0 ? 0 : hash >> (std::numeric_limits<std::size_t>::digits - stripeBits);
+}
+
+template <class T>
+static inline std::string encode_interned(const T& value) {
+  using Type = std::remove_cvref_t<T>;
+
+  std::string bytes{};
+  if constexpr (std::is_same_v<Type, std::string>) {
+    bytes = value;
+  } else if constexpr (std::is_same_v<Type, std::filesystem::path>) {
+    auto u8 = value.u8string();
+    bytes.assign(reinterpret_cast<const char*>(u8.data()), u8.size());
+  } else if constexpr (std::is_same_v<Type, mugen::def::MugenDefVersion>) {
+    bytes.resize(12);
+    mugen::def::internal::store_le<std::int32_t>(bytes.data(), value.month);
+    mugen::def::internal::store_le<std::int32_t>(bytes.data() + 4, value.day);
+    mugen::def::internal::store_le<std::int32_t>(bytes.data() + 8, value.year);
+  } else {
+    static_assert(std::is_same_v<Type, std::vector<std::int32_t>>);
+    bytes.resize(value.size() * 4);
+    for (std::size_t i = 0; i < value.size(); ++i) {
+      mugen::def::internal::store_le<std::int32_t>(bytes.data() + i * 4, value[i]);
+    }
+  }
+  return bytes;
+}
+
+template <class T>
+static inline T decode_interned(std::string_view bytes) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string{bytes};
+  } else if constexpr (std::is_same_v<T, std::filesystem::path>) {
+    return std::filesystem::path{std::u8string_view{reinterpret_cast<const char8_t*>(bytes.data()), bytes.size()}};
+  } else if constexpr (std::is_same_v<T, mugen::def::MugenDefVersion>) {
+    if (bytes.size() != 12) {
+      throw mugen::def::InvalidFormatError{"Interned version has an invalid length."};
+    }
+    return mugen::def::MugenDefVersion{.month = mugen::def::internal::load_le<std::int32_t>(bytes.data()),
+                                       .day = mugen::def::internal::load_le<std::int32_t>(bytes.data() + 4),
+                                       .year = mugen::def::internal::load_le<std::int32_t>(bytes.data() + 8)};
+  } else {
+    static_assert(std::is_same_v<T, std::vector<std::int32_t>>);
+    if (bytes.size() % 4 != 0) {
+      throw mugen::def::InvalidFormatError{"Interned pal.defaults has an invalid length."};
+    }
+    std::vector<std::int32_t> values(bytes.size() / 4);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      values[i] = mugen::def::internal::load_le<std::int32_t>(bytes.data() + i * 4);
+    }
+    return values;
+  }
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE mugen::def::StringPool::StringPool(std::size_t stripeCount) : stripes_{}, stripeBits_{0} {
+  auto count = std::bit_ceil(std::clamp<std::size_t>(stripeCount, 1, 256));
+  stripeBits_ = static_cast<unsigned>(std::countr_zero(count));
+
+  stripes_.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    stripes_.push_back(std::make_unique<Stripe>());
+  }
+}
+
+MDEFPARSER_INLINE mugen::def::StringHandle mugen::def::StringPool::intern(std::string_view value) {
+  auto hash = std::hash<std::string_view>{}(value);
+  auto stripeIndex = static_cast<StringHandle>(mugen::def::internal::string_pool_stripe(hash, stripeBits_));
+  auto& stripe = *stripes_[stripeIndex];
+
+  {
+    std::shared_lock lock{stripe.mutex};
+    auto it = stripe.lookup.find(value);
+    if (it != stripe.lookup.end()) {
+      return it->second;
+    }
+  }
+
+  std::unique_lock lock{stripe.mutex};
+  auto it = stripe.lookup.find(value);
+  if (it != stripe.lookup.end()) {
+    return it->second;
+  }
+
+  // 最大値は npos と重ならないようにする (32 ビット環境で size_t をシフトしすぎないよう 64 ビットで計算する)
+  if (static_cast<std::uint64_t>(stripe.entries.size()) >= (std::uint64_t{1} << (32 - stripeBits_)) - 1) {
+    throw mugen::def::LimitExceededError{"String pool is full."};
+  }
+
+  auto stored = store(stripe, value);
+  auto handle = static_cast<StringHandle>((stripe.entries.size() << stripeBits_) | stripeIndex);
+  stripe.entries.push_back(stored);
+  stripe.lookup.emplace(stored, handle);
+  return handle;
+}
+
+MDEFPARSER_INLINE std::optional<mugen::def::StringHandle> mugen::def::StringPool::find(std::string_view value) const {
+  auto hash = std::hash<std::string_view>{}(value);
+  auto& stripe = *stripes_[mugen::def::internal::string_pool_stripe(hash, stripeBits_)];
+
+  std::shared_lock lock{stripe.mutex};
+  auto it = stripe.lookup.find(value);
+  if (it == stripe.lookup.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+MDEFPARSER_INLINE std::string_view mugen::def::StringPool::view(StringHandle handle) const {
+  auto stripeIndex = handle & (stripes_.size() - 1);
+  auto index = static_cast<std::size_t>(handle >> stripeBits_);
+  auto& stripe = *stripes_[stripeIndex];
+
+  std::shared_lock lock{stripe.mutex};
+  if (handle == npos || index >= stripe.entries.size()) {
+    throw std::out_of_range{"Invalid string handle."};
+  }
+  return stripe.entries[index];
+}
+
+MDEFPARSER_INLINE std::size_t mugen::def::StringPool::size() const {
+  std::size_t count = 0;
+  for (auto& stripe : stripes_) {
+    std::shared_lock lock{stripe->mutex};
+    count += stripe->entries.size();
+  }
+  return count;
+}
+
+MDEFPARSER_INLINE std::size_t mugen::def::StringPool::memory_usage() const {
+  std::size_t bytes = 0;
+  for (auto& stripe : stripes_) {
+    std::shared_lock lock{stripe->mutex};
+    bytes += stripe->allocated;
+  }
+  return bytes;
+}
+
+MDEFPARSER_INLINE std::string_view mugen::def::StringPool::store(Stripe& stripe, std::string_view value) {
+  if (value.empty()) {
+    return std::string_view{};
+  }
+
+  // 大きな文字列は専用の領域に置き、共有のチャンクを無駄にしない
+  if (value.size() > mugen::def::internal::STRING_POOL_CHUNK_SIZE / 4) {
+    auto& block = stripe.large.emplace_back(std::make_unique_for_overwrite<char[]>(value.size()));
+    std::memcpy(block.get(), value.data(), value.size());
+    stripe.allocated += value.size();
+    return std::string_view{block.get(), value.size()};
+  }
+
+  if (stripe.chunks.empty() || stripe.chunkSize - stripe.chunkUsed < value.size()) {
+    stripe.chunks.push_back(std::make_unique_for_overwrite<char[]>(mugen::def::internal::STRING_POOL_CHUNK_SIZE));
+    stripe.chunkUsed = 0;
+    stripe.chunkSize = mugen::def::internal::STRING_POOL_CHUNK_SIZE;
+    stripe.allocated += mugen::def::internal::STRING_POOL_CHUNK_SIZE;
+  }
+
+  auto* dest = stripe.chunks.back().get() + stripe.chunkUsed;
+  std::memcpy(dest, value.data(), value.size());
+  stripe.chunkUsed += value.size();
+  return std::string_view{dest, value.size()};
+}
+
+MDEFPARSER_INLINE mugen::def::InternedDefWin mugen::def::intern(const mugen::def::MugenDefWin& def, mugen::def::StringPool& pool) {
+  mugen::def::InternedDefWin interned{};
+  interned.items.fill(mugen::def::StringPool::npos);
+
+  mugen::def::for_each_key([&](auto item) {
+    constexpr auto key = decltype(item)::value;
+    const auto& value = mugen::def::get_item<key>(def);
+    auto& handle = interned.items[static_cast<std::size_t>(key)];
+
+    if constexpr (mugen::def::is_required_item<key>) {
+      handle = pool.intern(mugen::def::internal::encode_interned(value));
+    } else {
+      if (value) {
+        handle = pool.intern(mugen::def::internal::encode_interned(*value));
+      }
+    }
+  });
+
+  return interned;
+}
+
+MDEFPARSER_INLINE mugen::def::MugenDefWin mugen::def::materialize(const mugen::def::InternedDefWin& def, const mugen::def::StringPool& pool) {
+  mugen::def::MugenDefWin result{};
+
+  mugen::def::for_each_key([&](auto item) {
+    constexpr auto key = decltype(item)::value;
+    using Type = typename mugen::def::DefItemType<key>::type;
+    auto handle = def.items[static_cast<std::size_t>(key)];
+
+    if (handle == mugen::def::StringPool::npos) {
+      if constexpr (mugen::def::is_required_item<key>) {
+        throw mugen::def::MissingKeyError{"Required parameter does not exist."};
+      }
+      return;
+    }
+    mugen::def::get_item<key>(result) = mugen::def::internal::decode_interned<Type>(pool.view(handle));
+  });
+
+  return result;
+}
+
+MDEFPARSER_INLINE std::vector<mugen::def::BatchResult<mugen::def::InternedDefWin>> mugen::def::parse_batch_interned(
+    mugen::def::DefParserWin& parser,
+    std::span<const std::filesystem::path> paths,
+    mugen::def::StringPool& pool,
+    unsigned jobs) {
+  std::vector<mugen::def::BatchResult<mugen::def::InternedDefWin>> results(paths.size());
+  mugen::def::parse_batch(
+      parser,
+      paths,
+      [&](std::size_t i, mugen::def::BatchResult<mugen::def::MugenDefWin>&& result) {
+        if (!result) {
+          results[i].error = result.error;
+          return;
+        }
+        try {
+          results[i].value = mugen::def::intern(*result.value, pool);
+        } catch (...) {
+          results[i].error = std::current_exception();
+        }
+      },
+      jobs);
+  return results;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file line_reader.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_IMPL_LINE_READER_HPP__
+#define MDEFPARSER_IMPL_LINE_READER_HPP__
+
+#include "mdefparser/impl/portable_file.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+class ReadOnlyFile;
+
+// ファイルをまとめて読み込みながら 1 行ずつ返す
+// 返した行はバッファを指すため、次に next() を呼ぶまでのみ有効
+// maxLineLength を超える行に出会った場合は LimitExceededError を投げる
+// Source は size() と read_at() を持つもの (ReadOnlyFile, StdioFile, MemoryFile)
+template <class Source>
+class BasicLineReader {
+ public:
+  BasicLineReader(const BasicLineReader&) = delete;
+  BasicLineReader& operator=(const BasicLineReader&) = delete;
+
+  explicit BasicLineReader(const Source& file,
+                      std::size_t chunkSize = 0x10000,
+                      std::size_t maxLineLength = std::numeric_limits<std::size_t>::max())
+      : file_{file},
+        buffer_(initial_size(file, chunkSize)),
+        begin_{0},
+        end_{0},
+        bufferOffset_{0},
+        lineOffset_{0},
+        maxLineLength_{maxLineLength},
+        eof_{false} {}
+
+  // 改行文字 (\n, \r\n) を除いた次の行を返す
+  bool next(std::string_view& line) {
+    while (true) {
+      auto* first = buffer_.data() + begin_;
+      auto* newline = static_cast<char*>(std::memchr(first, '\n', end_ - begin_));
+      if (newline) {
+        return take(line, static_cast<std::size_t>(newline - buffer_.data()), 1);
+      }
+      if (eof_) {
+        if (begin_ == end_) {
+          return false;
+        }
+        return take(line, end_, 0);
+      }
+      // 改行が見つからないまま上限を超えた場合はそれ以上読み込まない
+      if (end_ - begin_ > maxLineLength_) {
+        throw mugen::def::LimitExceededError{"Line length exceeds the limit."};
+      }
+      fill();
+    }
+  }
+
+  // 直前に返した行の先頭のファイル内オフセット
+  std::uint64_t line_offset() const noexcept {
+    return lineOffset_;
+  }
+
+  // 次の行の先頭のファイル内オフセット
+  std::uint64_t offset() const noexcept {
+    return bufferOffset_ + begin_;
+  }
+
+  // ファイルから読み込み済みのバイト数
+  std::uint64_t read_offset() const noexcept {
+    return bufferOffset_ + end_;
+  }
+
+  // 次の next() がファイルを読まずに済むか
+  bool buffered() const noexcept {
+    if (eof_) {
+      return true;
+    }
+    return std::memchr(buffer_.data() + begin_, '\n', end_ - begin_) != nullptr;
+  }
+
+ private:
+  // 小さいファイルのために必要以上のバッファを確保しない
+  static std::size_t initial_size(const Source& file, std::size_t chunkSize) noexcept {
+    return static_cast<std::size_t>(std::clamp<std::uint64_t>(file.size(), 1, chunkSize));
+  }
+
+  bool take(std::string_view& line, std::size_t last, std::size_t skip) {
+    std::size_t length = last - begin_;
+    if (length > 0 && buffer_[begin_ + length - 1] == '\r') {
+      --length;
+    }
+    if (length > maxLineLength_) {
+      throw mugen::def::LimitExceededError{"Line length exceeds the limit."};
+    }
+
+    line = std::string_view{buffer_.data() + begin_, length};
+    lineOffset_ = bufferOffset_ + begin_;
+    begin_ = last + skip;
+    return true;
+  }
+
+  void fill() {
+    // 未処理のデータを先頭に詰めてから続きを読み込む
+    if (begin_ > 0) {
+      std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+      bufferOffset_ += begin_;
+      end_ -= begin_;
+      begin_ = 0;
+    }
+    if (end_ == buffer_.size()) {
+      buffer_.resize(buffer_.size() * 2);
+    }
+
+    auto read = file_.read_at(bufferOffset_ + end_, buffer_.data() + end_, buffer_.size() - end_);
+    end_ += read;
+    if (read == 0 || bufferOffset_ + end_ >= file_.size()) {
+      eof_ = true;
+    }
+  }
+
+  const Source& file_;
+  std::vector<char> buffer_;
+  std::size_t begin_;
+  std::size_t end_;
+  std::uint64_t bufferOffset_;
+  std::uint64_t lineOffset_;
+  std::size_t maxLineLength_;
+  bool eof_;
+};
+
+// ReadOnlyFile は impl/file.hpp で定義する
+using LineReader = BasicLineReader<ReadOnlyFile>;
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_IMPL_LINE_READER_HPP__
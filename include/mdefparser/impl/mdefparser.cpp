@@ -26,165 +26,41 @@
 #endif
 
 #include "mdefparser/mdefparser.h"
+#include "mdefparser/impl/line_reader.hpp"
+#include "mdefparser/impl/tokenizer.hpp"
+#include "mdefparser/impl/visit_file.hpp"
 
 #include <array>
 #include <cctype>
 #include <cstring>
-#include <fstream>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
-
-#include <iostream>
+#include <string_view>
 
 namespace mugen {
 namespace def {
 namespace internal {
 
-using namespace std::string_view_literals;
-
-static inline void tolowers(std::string& str, size_t count = std::string::npos) noexcept {
-  if (count == std::string::npos) {
-    count = str.size();
-  }
-
-  for (size_t i = 0; i < count; ++i) {
-    str[i] = static_cast<char>(std::tolower(str[i]));
-  }
-}
-
-static inline std::string trimline(char* line) noexcept {
-  // Remove comment
-  char* p = std::strchr(line, ';');
-  if (p) {
-    *p = '\0';
-  }
-
-  // ltrim
-  size_t len = std::strlen(line);
-  size_t start = std::strspn(line, " \t\n");
-  if (start > 0) {
-    std::memmove(line, &line[start], len + 1 - start);
-    len -= start;
-  }
-
-  // rtrim
-  char c;
-  while (len > 0 && ((c = line[len - 1]) == ' ' || c == '\t' || c == '\n')) {
-    line[len - 1] = '\0';
-    --len;
-  }
-
-  return std::string(line, len + 1);
-}
-
-static inline std::optional<std::array<std::string_view, 2>> get_key_value(std::string& line) noexcept {
-  // 文字「=」、文字「 」がKeyの中に含まれるケースは想定しない
-
-  size_t delim = line.find_first_of(" \t\n=");
-  if (delim == std::string::npos) {
-    return std::nullopt;
-  }
-
-  // 「=」の位置を特定
-  size_t eqpos = delim;
-  if (line[eqpos] != '=') {
-    eqpos = line.find_first_of('=');
-    if (eqpos == std::string::npos) {
-      return std::nullopt;
-    }
-  }
-
-  // 元の文字列を Key と Value で分割
-  line.data()[delim] = '\0';
-
-  // key は小文字化して返却
-  mugen::def::internal::tolowers(line, delim);
-  std::string_view key(line.data(), delim + 1);
-
-  // value のみ見つからない場合は 空文字列 を返させる
-  size_t offset = line.find_first_not_of(" \t\n", eqpos + 1);
-  if (offset == std::string::npos) {
-    return std::make_optional<std::array<std::string_view, 2>>({key, ""sv});
-  }
-
-  std::string_view value(&line.data()[offset]);
-  return std::make_optional<std::array<std::string_view, 2>>({key, value});
+// prefixBytes が指定されている場合は最初の読み込みをその大きさにする
+static inline std::size_t chunk_size(const mugen::def::ParseLimits& limits) noexcept {
+  return limits.prefixBytes > 0 ? limits.prefixBytes : 0x10000;
 }
 
-static inline std::optional<std::string_view> dequote_string(std::string_view value) noexcept {
-  size_t len = value.size();
-  if (value[0] == '\"' && value[len - 1] == '\"') {
-    return value.substr(1, len - 2);
-  } else {
-    return std::nullopt;
-  }
+// prefixBytes を読み終え、読み込み済みの行も使い切ったか
+template <class Reader>
+static inline bool prefix_consumed(const Reader& reader, const mugen::def::ParseLimits& limits) noexcept {
+  return limits.prefixBytes > 0 && reader.read_offset() >= limits.prefixBytes && !reader.buffered();
 }
 
-static inline mugen::def::MugenDefVersion convert_to_version(std::string_view value) noexcept {
-  std::array<std::int32_t, 3> mdy{0, 0, 0};
-
-  size_t start = 0;
-  size_t cnt = 0;
-  while (cnt < 3) {
-    size_t last = value.find_first_of(',', start);
-    try {
-      mdy[cnt] = std::stoi(std::string{value.substr(start, last - start)});
-    } catch (...) {
-      break;
-    }
-
-    if (last == std::string_view::npos) {
-      break;
-    }
-    start = last + 1;
-    ++cnt;
-  }
-
-  return mugen::def::MugenDefVersion{.month = mdy[0], .day = mdy[1], .year = mdy[2]};
-}
-
-static inline std::vector<std::int32_t> parse_pal_defaults(std::string_view value) noexcept {
-  // pal.defaults は 先頭4つのみ有効なので、
-  // 最大長は4とする
-
-  // 途中で数字以外が出現した場合はそこで打ち切り
-  // 例) 1, 2, foo, 3 => {1, 2}
-
-  std::vector<std::int32_t> vec{};
-
-  size_t start = 0;
-  while (vec.size() < 4) {
-    size_t last = value.find_first_of(',', start);
-    try {
-      vec.push_back(std::stoi(std::string{value.substr(start, last - start)}));
-    } catch (...) {
-      return vec;
-    }
-
-    if (last == std::string_view::npos) {
-      break;
-    }
-    start = last + 1;
-  }
-
-  return vec;
-}
-
-};  // namespace internal
-};  // namespace def
-};  // namespace mugen
-
-template <>
-MDEFPARSER_INLINE mugen::def::DefParserWin::DefParser() noexcept {}
-
-template <>
-MDEFPARSER_INLINE mugen::def::MugenDefWin mugen::def::DefParserWin::parse(const std::filesystem::path& path) {
-  if (!std::filesystem::exists(path) || !std::filesystem::is_regular_file(path)) {
-    throw mugen::def::FileIOError{"Can't find the specified file."};
+template <class Source>
+static inline mugen::def::MugenDefWin parse_def_win(const Source& file, const mugen::def::ParseLimits& limits) {
+  if (file.size() > limits.maxFileSize) {
+    throw mugen::def::LimitExceededError{"File size exceeds the limit."};
   }
 
-  std::ifstream fs{path, std::ios_base::in};
+  mugen::def::internal::BasicLineReader<Source> reader{file, mugen::def::internal::chunk_size(limits), limits.maxLineLength};
 
   bool inInfo = false;
   bool inFiles = false;
@@ -235,17 +111,27 @@ MDEFPARSER_INLINE mugen::def::MugenDefWin mugen::def::DefParserWin::parse(const
   std::optional<std::filesystem::path> intro{};
   std::optional<std::filesystem::path> ending{};
 
-  char buffer[0x100];
+  std::size_t sectionCount = 0;
+  std::string buffer{};
+  std::string_view rawLine{};
   while (true) {
-    fs.getline(buffer, sizeof(buffer));
-    if (fs.bad() || fs.eof()) {
+    if (name && cmd && cns && st && sprite && anim && mugen::def::internal::prefix_consumed(reader, limits)) {
       break;
     }
-    if (fs.fail()) {
-      fs.clear(fs.rdstate() & ~std::ios_base::failbit);
+    if (!reader.next(rawLine)) {
+      break;
+    }
+
+    if (!(hasInfo && hasFiles) && reader.offset() > limits.maxScanBytes) {
+      throw mugen::def::LimitExceededError{"Required sections were not found within the scan limit."};
+    }
+
+    buffer.assign(rawLine);
+    auto line = mugen::def::internal::trimline(buffer.data());
+    if (line[0] == '[' && ++sectionCount > limits.maxSections) {
+      throw mugen::def::LimitExceededError{"Section count exceeds the limit."};
     }
 
-    auto line = mugen::def::internal::trimline(buffer);
     if (inInfo || inFiles || inArcade) {
       if (line[0] == '[') {
         inInfo = false;
@@ -488,31 +374,95 @@ MDEFPARSER_INLINE mugen::def::MugenDefWin mugen::def::DefParserWin::parse(const
                                         .pal10 = pal10,
                                         .pal11 = pal11,
                                         .pal12 = pal12},
-                                 .arcade{.intro = intro, .ending = ending}};
+                                 .arcade{.intro = intro, .ending = ending, .introStoryboard = std::nullopt, .endingStoryboard = std::nullopt}};
 }
 
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
 template <>
-template <mugen::def::DefParseKey Key>
-MDEFPARSER_INLINE typename mugen::def::DefItemType<Key>::type mugen::def::DefParserWin::parse_item(const std::filesystem::path& path) {
-  if (!std::filesystem::exists(path) || !std::filesystem::is_regular_file(path)) {
-    throw mugen::def::FileIOError{"Can't find the specified file."};
+MDEFPARSER_INLINE mugen::def::DefParserWin::DefParser() noexcept : limits_{}, source_{} {}
+
+template <>
+MDEFPARSER_INLINE mugen::def::DefParserWin::DefParser(const mugen::def::ParseLimits& limits) noexcept : limits_{limits}, source_{} {}
+
+template <>
+MDEFPARSER_INLINE mugen::def::DefParserWin::DefParser(std::shared_ptr<const mugen::def::FileSource> source,
+                                                      const mugen::def::ParseLimits& limits) noexcept
+    : limits_{limits}, source_{std::move(source)} {}
+
+template <>
+MDEFPARSER_INLINE const mugen::def::ParseLimits& mugen::def::DefParserWin::limits() const noexcept {
+  return limits_;
+}
+
+template <>
+MDEFPARSER_INLINE void mugen::def::DefParserWin::set_limits(const mugen::def::ParseLimits& limits) noexcept {
+  limits_ = limits;
+}
+
+template <>
+MDEFPARSER_INLINE const std::shared_ptr<const mugen::def::FileSource>& mugen::def::DefParserWin::source() const noexcept {
+  return source_;
+}
+
+template <>
+MDEFPARSER_INLINE void mugen::def::DefParserWin::set_source(std::shared_ptr<const mugen::def::FileSource> source) noexcept {
+  source_ = std::move(source);
+}
+
+template <>
+MDEFPARSER_INLINE mugen::def::MugenDefWin mugen::def::DefParserWin::parse(const std::filesystem::path& path) {
+  return mugen::def::internal::visit_file(source_.get(), path, [this](const auto& file) {
+    return mugen::def::internal::parse_def_win(file, limits_);
+  });
+}
+
+template <>
+MDEFPARSER_INLINE mugen::def::MugenDefWin mugen::def::DefParserWin::parse_buffer(std::string_view content) {
+  mugen::def::internal::MemoryFile file{content};
+  return mugen::def::internal::parse_def_win(file, limits_);
+}
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+template <mugen::def::DefParseKey Key, class Source>
+static inline typename mugen::def::DefItemType<Key>::type parse_item_win(const Source& file, const mugen::def::ParseLimits& limits) {
+  if (file.size() > limits.maxFileSize) {
+    throw mugen::def::LimitExceededError{"File size exceeds the limit."};
   }
 
-  std::ifstream fs{path, std::ios_base::in};
+  mugen::def::internal::BasicLineReader<Source> reader{file, mugen::def::internal::chunk_size(limits), limits.maxLineLength};
 
   bool inTargetSection = false;
 
-  char buffer[0x100];
+  std::size_t sectionCount = 0;
+  std::string buffer{};
+  std::string_view rawLine{};
   while (true) {
-    fs.getline(buffer, sizeof(buffer));
-    if (fs.bad() || fs.eof()) {
+    // parse() と同様に、必須でない項目は prefixBytes より後を探さない
+    if constexpr (!mugen::def::is_required_item<Key>) {
+      if (mugen::def::internal::prefix_consumed(reader, limits)) {
+        break;
+      }
+    }
+    if (!reader.next(rawLine)) {
       break;
     }
-    if (fs.fail()) {
-      fs.clear(fs.rdstate() & ~std::ios_base::failbit);
+
+    if (!inTargetSection && reader.offset() > limits.maxScanBytes) {
+      throw mugen::def::LimitExceededError{"Required sections were not found within the scan limit."};
+    }
+
+    buffer.assign(rawLine);
+    auto line = mugen::def::internal::trimline(buffer.data());
+    if (line[0] == '[' && ++sectionCount > limits.maxSections) {
+      throw mugen::def::LimitExceededError{"Section count exceeds the limit."};
     }
 
-    auto line = mugen::def::internal::trimline(buffer);
     if (inTargetSection) {
       if (line[0] == '[') {
         break;
@@ -552,6 +502,18 @@ MDEFPARSER_INLINE typename mugen::def::DefItemType<Key>::type mugen::def::DefPar
   throw mugen::def::MissingKeyError{"Required parameter does not exist."};
 }
 
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+template <>
+template <mugen::def::DefParseKey Key>
+MDEFPARSER_INLINE typename mugen::def::DefItemType<Key>::type mugen::def::DefParserWin::parse_item(const std::filesystem::path& path) {
+  return mugen::def::internal::visit_file(source_.get(), path, [this](const auto& file) {
+    return mugen::def::internal::parse_item_win<Key>(file, limits_);
+  });
+}
+
 #ifndef MDEFPARSER_HEADER_ONLY
 template class mugen::def::DefParser<mugen::def::MugenVersion::Win>;
 
@@ -0,0 +1,205 @@
+/**
+ * @file mdefparser_c.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/mdefparser_c.h"
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/async.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+static_assert(MDEF_KEY_COUNT == mugen::def::DefParseKeyCount);
+static_assert(MDEF_KEY_PAL_DEFAULTS == static_cast<int>(mugen::def::DefParseKey::PalDefaults));
+static_assert(MDEF_KEY_SPRITE == static_cast<int>(mugen::def::DefParseKey::Sprite));
+static_assert(MDEF_KEY_ENDING == static_cast<int>(mugen::def::DefParseKey::Ending));
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+static inline std::int32_t status_of(const std::exception_ptr& error) noexcept {
+  try {
+    std::rethrow_exception(error);
+  } catch (const mugen::def::FileIOError&) {
+    return MDEF_ERROR_FILE_IO;
+  } catch (const mugen::def::DequotationError&) {
+    return MDEF_ERROR_DEQUOTATION;
+  } catch (const mugen::def::MissingKeyError&) {
+    return MDEF_ERROR_MISSING_KEY;
+  } catch (const mugen::def::InvalidFormatError&) {
+    return MDEF_ERROR_INVALID_FORMAT;
+  } catch (const mugen::def::LimitExceededError&) {
+    return MDEF_ERROR_LIMIT_EXCEEDED;
+  } catch (const mugen::def::InsufficientBufferError&) {
+    return MDEF_ERROR_INSUFFICIENT_BUFFER;
+  } catch (...) {
+    return MDEF_ERROR_UNKNOWN;
+  }
+}
+
+static inline mdef_version to_c_version(const std::optional<mugen::def::MugenDefVersion>& version) noexcept {
+  if (!version) {
+    return mdef_version{0, 0, 0, 0};
+  }
+  return mdef_version{version->month, version->day, version->year, 1};
+}
+
+// 文字列の項目を (項目, 内容) の組として列挙する
+template <class Function>
+static inline void for_each_c_string(const mugen::def::MugenDefWin& def, Function&& function) {
+  mugen::def::for_each_key([&](auto item) {
+    const auto& value = mugen::def::get_item<item.value>(def);
+    using Type = typename mugen::def::DefItemType<item.value>::type;
+
+    auto emit = [&](const Type& present) {
+      if constexpr (std::is_same_v<Type, std::string>) {
+        function(item.value, std::string_view{present});
+      } else if constexpr (std::is_same_v<Type, std::filesystem::path>) {
+        auto u8 = present.u8string();
+        function(item.value, std::string_view{reinterpret_cast<const char*>(u8.data()), u8.size()});
+      }
+    };
+    if constexpr (mugen::def::is_required_item<item.value>) {
+      emit(value);
+    } else if (value) {
+      emit(*value);
+    }
+  });
+}
+
+static inline void fill_c_result(const mugen::def::MugenDefWin& def,
+                                 mdef_result& result,
+                                 char* strings,
+                                 std::size_t capacity,
+                                 std::atomic<std::size_t>& used,
+                                 std::atomic<std::size_t>& required) {
+  std::size_t size = 0;
+  mugen::def::internal::for_each_c_string(def, [&](mugen::def::DefParseKey, std::string_view value) { size += value.size() + 1; });
+  required.fetch_add(size, std::memory_order_relaxed);
+
+  // 他のスレッドと strings を取り合うため、入りきる場合のみ領域を確保する
+  auto offset = used.load(std::memory_order_relaxed);
+  do {
+    if (capacity - offset < size) {
+      result.status = MDEF_ERROR_INSUFFICIENT_BUFFER;
+      return;
+    }
+  } while (!used.compare_exchange_weak(offset, offset + size, std::memory_order_relaxed));
+
+  mugen::def::internal::for_each_c_string(def, [&](mugen::def::DefParseKey key, std::string_view value) {
+    std::memcpy(strings + offset, value.data(), value.size());
+    strings[offset + value.size()] = '\0';
+    result.items[static_cast<std::size_t>(key)] = mdef_string{offset, static_cast<std::uint32_t>(value.size()), 1};
+    offset += value.size() + 1;
+  });
+
+  if (def.info.palDefaults) {
+    const auto& palDefaults = *def.info.palDefaults;
+    result.palDefaultsCount = static_cast<std::int32_t>(std::min<std::size_t>(palDefaults.size(), std::size(result.palDefaults)));
+    std::copy_n(palDefaults.begin(), result.palDefaultsCount, result.palDefaults);
+  }
+  result.versionDate = mugen::def::internal::to_c_version(def.info.versionDate);
+  result.mugenVersion = mugen::def::internal::to_c_version(def.info.mugenVersion);
+  result.status = MDEF_OK;
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+extern "C" MDEFPARSER_INLINE MDEF_API uint32_t mdef_abi_version(void) {
+  return MDEF_ABI_VERSION;
+}
+
+extern "C" MDEFPARSER_INLINE MDEF_API const char* mdef_status_message(int32_t status) {
+  switch (status) {
+    case MDEF_OK:
+      return "OK";
+    case MDEF_ERROR_FILE_IO:
+      return "Failed to read the file.";
+    case MDEF_ERROR_DEQUOTATION:
+      return "Failed to dequote a value.";
+    case MDEF_ERROR_MISSING_KEY:
+      return "A required key is missing.";
+    case MDEF_ERROR_INVALID_FORMAT:
+      return "Invalid format.";
+    case MDEF_ERROR_LIMIT_EXCEEDED:
+      return "The input exceeds a parse limit.";
+    case MDEF_ERROR_INSUFFICIENT_BUFFER:
+      return "The string buffer is too small.";
+    default:
+      return "Unknown error.";
+  }
+}
+
+extern "C" MDEFPARSER_INLINE MDEF_API size_t mdef_parse_batch(const char* const* paths,
+                                                              size_t count,
+                                                              mdef_result* results,
+                                                              char* strings,
+                                                              size_t stringsCapacity,
+                                                              unsigned jobs) {
+  // C から呼ばれるため例外を外に出さない
+  std::fill_n(results, count, mdef_result{MDEF_ERROR_UNKNOWN, 0, {}, {}, {}, {}});
+  std::atomic<std::size_t> used{0};
+  std::atomic<std::size_t> required{0};
+  try {
+    std::vector<std::filesystem::path> files{};
+    files.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      files.emplace_back(std::u8string_view{reinterpret_cast<const char8_t*>(paths[i])});
+    }
+
+    mugen::def::DefParserWin parser{};
+    mugen::def::parse_batch(
+        parser,
+        files,
+        [&](std::size_t i, mugen::def::BatchResult<mugen::def::MugenDefWin>&& result) {
+          if (!result.value) {
+            results[i].status = mugen::def::internal::status_of(result.error);
+            return;
+          }
+          try {
+            mugen::def::internal::fill_c_result(*result.value, results[i], strings, stringsCapacity, used, required);
+          } catch (...) {
+            results[i].status = MDEF_ERROR_UNKNOWN;
+          }
+        },
+        jobs);
+  } catch (...) {
+  }
+  return required.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,176 @@
+/**
+ * @file mpmc_queue.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_IMPL_MPMC_QUEUE_HPP__
+#define MDEFPARSER_IMPL_MPMC_QUEUE_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+// 容量固定のロックフリーな MPMC キュー (Dmitry Vyukov の bounded MPMC queue)
+// try_push() / try_pop() はロックを取らない
+// push() / pop() は満杯・空の間 std::atomic::wait() で待つ
+template <class T>
+class MpmcQueue {
+ public:
+  MpmcQueue(const MpmcQueue&) = delete;
+  MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+  // 容量は 2 のべき乗に切り上げる
+  explicit MpmcQueue(std::size_t capacity)
+      : mask_{std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1},
+        cells_{std::make_unique<Cell[]>(mask_ + 1)},
+        enqueuePos_{0},
+        dequeuePos_{0},
+        pushes_{0},
+        pops_{0},
+        closed_{false},
+        cancelled_{false} {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  bool try_push(T& value) {
+    auto pos = enqueuePos_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& cell = cells_[pos & mask_];
+      auto sequence = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.value.emplace(std::move(value));
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueuePos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool try_pop(T& value) {
+    auto pos = dequeuePos_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& cell = cells_[pos & mask_];
+      auto sequence = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          value = std::move(*cell.value);
+          cell.value.reset();
+          cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeuePos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // cancel() された場合は積まずに false を返す
+  bool push(T&& value) {
+    while (true) {
+      auto seen = pops_.load(std::memory_order_acquire);
+      if (cancelled_.load(std::memory_order_acquire)) {
+        return false;
+      }
+      if (try_push(value)) {
+        pushes_.fetch_add(1, std::memory_order_release);
+        pushes_.notify_all();
+        return true;
+      }
+      pops_.wait(seen, std::memory_order_acquire);
+    }
+  }
+
+  // close() された後に空になった場合は false を返す
+  bool pop(T& value) {
+    while (true) {
+      auto seen = pushes_.load(std::memory_order_acquire);
+      if (try_pop(value)) {
+        pops_.fetch_add(1, std::memory_order_release);
+        pops_.notify_all();
+        return true;
+      }
+      if (closed_.load(std::memory_order_acquire)) {
+        // close() の前に積まれたものを取りこぼさないようにもう一度確認する
+        if (try_pop(value)) {
+          pops_.fetch_add(1, std::memory_order_release);
+          pops_.notify_all();
+          return true;
+        }
+        return false;
+      }
+      pushes_.wait(seen, std::memory_order_acquire);
+    }
+  }
+
+  // これ以上積まないことを通知し、pop() で待っているスレッドを起こす
+  void close() noexcept {
+    closed_.store(true, std::memory_order_release);
+    pushes_.fetch_add(1, std::memory_order_release);
+    pushes_.notify_all();
+  }
+
+  // push() で待っているスレッドを起こし、以降の push() を失敗させる
+  void cancel() noexcept {
+    cancelled_.store(true, std::memory_order_release);
+    pops_.fetch_add(1, std::memory_order_release);
+    pops_.notify_all();
+  }
+
+ private:
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    std::optional<T> value;
+  };
+
+  const std::size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+  // 生産者と消費者で別のキャッシュラインに置く
+  alignas(64) std::atomic<std::size_t> enqueuePos_;
+  alignas(64) std::atomic<std::size_t> dequeuePos_;
+  alignas(64) std::atomic<std::uint32_t> pushes_;
+  alignas(64) std::atomic<std::uint32_t> pops_;
+  std::atomic<bool> closed_;
+  std::atomic<bool> cancelled_;
+};
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_IMPL_MPMC_QUEUE_HPP__
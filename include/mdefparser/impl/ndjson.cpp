@@ -0,0 +1,292 @@
+/**
+ * @file ndjson.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/ndjson.hpp"
+#include "mdefparser/scan.hpp"
+#include "mdefparser/impl/parallel.hpp"
+
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+using namespace std::string_view_literals;
+
+// 正しい UTF-8 の先頭から何バイトが 1 文字かを返す (不正な場合は 0)
+static inline std::size_t utf8_sequence_length(std::string_view str, std::size_t pos) noexcept {
+  auto c = static_cast<unsigned char>(str[pos]);
+  std::size_t length;
+  std::uint32_t min;
+  if (c < 0x80) {
+    return 1;
+  } else if ((c & 0xE0) == 0xC0) {
+    length = 2;
+    min = 0x80;
+  } else if ((c & 0xF0) == 0xE0) {
+    length = 3;
+    min = 0x800;
+  } else if ((c & 0xF8) == 0xF0) {
+    length = 4;
+    min = 0x10000;
+  } else {
+    return 0;
+  }
+
+  if (pos + length > str.size()) {
+    return 0;
+  }
+
+  std::uint32_t codepoint = c & (0x7F >> length);
+  for (std::size_t i = 1; i < length; ++i) {
+    auto cc = static_cast<unsigned char>(str[pos + i]);
+    if ((cc & 0xC0) != 0x80) {
+      return 0;
+    }
+    codepoint = (codepoint << 6) | (cc & 0x3F);
+  }
+
+  // 冗長な表現・サロゲート・範囲外は不正とする
+  if (codepoint < min || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+    return 0;
+  }
+  return length;
+}
+
+static inline bool is_valid_utf8(std::string_view str) noexcept {
+  for (std::size_t pos = 0; pos < str.size();) {
+    auto length = mugen::def::internal::utf8_sequence_length(str, pos);
+    if (length == 0) {
+      return false;
+    }
+    pos += length;
+  }
+  return true;
+}
+
+// UTF-8 として不正なため各バイトをエスケープした場合は true を返す
+static inline bool append_json_string(std::string& out, std::string_view str) {
+  static constexpr char hex[] = "0123456789abcdef";
+
+  // UTF-8 でない場合は ASCII 以外のバイトもすべてエスケープする
+  bool escapeHighBytes = !mugen::def::internal::is_valid_utf8(str);
+
+  out.push_back('"');
+  std::size_t run = 0;
+  for (std::size_t pos = 0; pos < str.size(); ++pos) {
+    auto c = static_cast<unsigned char>(str[pos]);
+    bool plain = c >= 0x20 && c != '"' && c != '\\' && (c < 0x80 || !escapeHighBytes);
+    if (plain) {
+      continue;
+    }
+
+    // エスケープ不要な区間はまとめて追加する
+    out.append(str.data() + run, pos - run);
+    run = pos + 1;
+
+    switch (c) {
+      case '"':
+        out.append("\\\""sv);
+        break;
+      case '\\':
+        out.append("\\\\"sv);
+        break;
+      case '\n':
+        out.append("\\n"sv);
+        break;
+      case '\r':
+        out.append("\\r"sv);
+        break;
+      case '\t':
+        out.append("\\t"sv);
+        break;
+      default:
+        out.append("\\u00"sv);
+        out.push_back(hex[c >> 4]);
+        out.push_back(hex[c & 0xF]);
+        break;
+    }
+  }
+  out.append(str.data() + run, str.size() - run);
+  out.push_back('"');
+  return escapeHighBytes;
+}
+
+// バイト単位でエスケープした値の後に "<key>Encoding":"bytes" を追加する
+static inline void append_json_encoding(std::string& out, std::string_view key, bool bytes) {
+  if (!bytes) {
+    return;
+  }
+  out.append(",\""sv);
+  out.append(key);
+  out.append("Encoding\":\"bytes\""sv);
+}
+
+static inline void append_json_int(std::string& out, std::int32_t value) {
+  char buffer[16];
+  auto [ptr, ec] = std::to_chars(std::begin(buffer), std::end(buffer), value);
+  out.append(buffer, ptr);
+}
+
+static inline bool append_json_value(std::string& out, const std::string& value) {
+  return mugen::def::internal::append_json_string(out, value);
+}
+
+// string() は Windows ではコードページで変換されるので u8string() を使う
+static inline bool append_json_path(std::string& out, const std::filesystem::path& path) {
+  auto u8 = path.u8string();
+  return mugen::def::internal::append_json_string(out, std::string_view{reinterpret_cast<const char*>(u8.data()), u8.size()});
+}
+
+static inline bool append_json_value(std::string& out, const std::filesystem::path& value) {
+  return mugen::def::internal::append_json_path(out, value);
+}
+
+static inline bool append_json_value(std::string& out, const mugen::def::MugenDefVersion& value) {
+  out.push_back('[');
+  mugen::def::internal::append_json_int(out, value.month);
+  out.push_back(',');
+  mugen::def::internal::append_json_int(out, value.day);
+  out.push_back(',');
+  mugen::def::internal::append_json_int(out, value.year);
+  out.push_back(']');
+  return false;
+}
+
+static inline bool append_json_value(std::string& out, const std::vector<std::int32_t>& value) {
+  out.push_back('[');
+  for (std::size_t i = 0; i < value.size(); ++i) {
+    if (i > 0) {
+      out.push_back(',');
+    }
+    mugen::def::internal::append_json_int(out, value[i]);
+  }
+  out.push_back(']');
+  return false;
+}
+
+static inline void append_json_line(std::string& out,
+                                    const std::filesystem::path& path,
+                                    const mugen::def::MugenDefWin& def,
+                                    const mugen::def::DefKeySet& keys) {
+  out.append("{\"path\":"sv);
+  mugen::def::internal::append_json_encoding(out, "path"sv, mugen::def::internal::append_json_path(out, path));
+
+  mugen::def::for_each_key([&](auto key) {
+    if (!keys.test(static_cast<std::size_t>(key.value))) {
+      return;
+    }
+
+    const auto& item = mugen::def::get_item<key.value>(def);
+    auto append = [&](const auto& value) {
+      out.append(",\""sv);
+      out.append(mugen::def::DefItemType<key.value>::key);
+      out.append("\":"sv);
+      mugen::def::internal::append_json_encoding(out, mugen::def::DefItemType<key.value>::key,
+                                                 mugen::def::internal::append_json_value(out, value));
+    };
+
+    if constexpr (mugen::def::is_required_item<key.value>) {
+      append(item);
+    } else if (item) {
+      append(*item);
+    }
+  });
+
+  out.append("}\n"sv);
+}
+
+static inline void append_json_error_line(std::string& out, const std::filesystem::path& path, std::string_view message) {
+  out.append("{\"path\":"sv);
+  mugen::def::internal::append_json_encoding(out, "path"sv, mugen::def::internal::append_json_path(out, path));
+  out.append(",\"error\":"sv);
+  mugen::def::internal::append_json_string(out, message);
+  out.append("}\n"sv);
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE mugen::def::NdjsonWriter::NdjsonWriter(std::ostream& out, const mugen::def::DefKeySet& keys) noexcept
+    : out_{out}, keys_{keys}, buffer_{} {}
+
+MDEFPARSER_INLINE void mugen::def::NdjsonWriter::write(const std::filesystem::path& path, const mugen::def::MugenDefWin& def) {
+  buffer_.clear();
+  mugen::def::internal::append_json_line(buffer_, path, def, keys_);
+  out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+}
+
+MDEFPARSER_INLINE void mugen::def::NdjsonWriter::write_error(const std::filesystem::path& path, std::string_view message) {
+  buffer_.clear();
+  mugen::def::internal::append_json_error_line(buffer_, path, message);
+  out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+}
+
+MDEFPARSER_INLINE mugen::def::NdjsonExportSummary mugen::def::export_ndjson(std::span<const std::filesystem::path> paths,
+                                                                             std::ostream& out,
+                                                                             unsigned jobs) {
+  std::mutex outMutex{};
+  std::atomic<std::size_t> failed{0};
+  auto keys = mugen::def::DefKeySet{}.set();
+
+  auto parser = mugen::def::DefParserWin{};
+  mugen::def::parse_in_locality_order(
+      paths,
+      parser,
+      [&](std::size_t i, mugen::def::BatchResult<mugen::def::MugenDefWin>&& result) {
+        // 行の組み立てはスレッドごとのバッファで行い、書き込みのみ排他する
+        thread_local std::string buffer{};
+        buffer.clear();
+
+        if (result) {
+          mugen::def::internal::append_json_line(buffer, paths[i], *result.value, keys);
+        } else {
+          try {
+            std::rethrow_exception(result.error);
+          } catch (const std::exception& e) {
+            mugen::def::internal::append_json_error_line(buffer, paths[i], e.what());
+          } catch (...) {
+            mugen::def::internal::append_json_error_line(buffer, paths[i], "unknown error"sv);
+          }
+          failed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::lock_guard lock{outMutex};
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      },
+      jobs);
+
+  auto failures = failed.load();
+  return mugen::def::NdjsonExportSummary{.succeeded = paths.size() - failures, .failed = failures};
+}
@@ -0,0 +1,126 @@
+/**
+ * @file palette.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/palette.hpp"
+#include "mdefparser/impl/file.hpp"
+#include "mdefparser/impl/parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+static inline void read_act(const std::filesystem::path& path, std::span<std::uint8_t, mugen::def::RGBA_PALETTE_SIZE> rgba) {
+  mugen::def::internal::ReadOnlyFile file{path};
+
+  // Photoshop の ACT は末尾に色数などの 4 バイトが付くことがあるので、先頭 768 バイトのみ読む
+  std::uint8_t act[mugen::def::ACT_FILE_SIZE];
+  if (file.size() < sizeof(act) || file.read_at(0, act, sizeof(act)) != sizeof(act)) {
+    throw mugen::def::InvalidFormatError{"The specified file is not ACT."};
+  }
+  mugen::def::act_to_rgba(act, rgba);
+}
+
+template <std::size_t... I>
+static inline std::array<const std::optional<std::filesystem::path>*, mugen::def::PALETTE_SLOT_COUNT> palette_items(
+    const mugen::def::MugenDefWin& def,
+    std::index_sequence<I...>) noexcept {
+  return {&mugen::def::get_item<static_cast<mugen::def::DefParseKey>(static_cast<std::size_t>(mugen::def::DefParseKey::Pal1) + I)>(def)...};
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE void mugen::def::act_to_rgba(std::span<const std::uint8_t, mugen::def::ACT_FILE_SIZE> act,
+                                               std::span<std::uint8_t, mugen::def::RGBA_PALETTE_SIZE> rgba) noexcept {
+  // 分岐のない単純なループにしてコンパイラーにベクトル化させる
+  const auto* in = act.data();
+  auto* out = rgba.data();
+  for (std::size_t i = 0; i < 256; ++i) {
+    const auto* color = in + (255 - i) * 3;
+    out[i * 4 + 0] = color[0];
+    out[i * 4 + 1] = color[1];
+    out[i * 4 + 2] = color[2];
+    out[i * 4 + 3] = 0xFF;
+  }
+  out[3] = 0;
+}
+
+MDEFPARSER_INLINE mugen::def::ActReader::ActReader() noexcept {}
+
+MDEFPARSER_INLINE std::vector<std::uint8_t> mugen::def::ActReader::read(const std::filesystem::path& path) {
+  std::vector<std::uint8_t> rgba(mugen::def::RGBA_PALETTE_SIZE);
+  mugen::def::internal::read_act(path, std::span<std::uint8_t, mugen::def::RGBA_PALETTE_SIZE>{rgba.data(), rgba.size()});
+  return rgba;
+}
+
+MDEFPARSER_INLINE mugen::def::PaletteSet mugen::def::ActReader::read_palettes(std::span<const mugen::def::CatalogEntry> entries,
+                                                                              unsigned jobs) {
+  mugen::def::PaletteSet result{};
+  result.slots.assign(entries.size() * mugen::def::PALETTE_SLOT_COUNT, mugen::def::PaletteSet::npos);
+
+  // 複数の def から参照されるパレットも 1 度だけ読み込む
+  std::unordered_map<std::filesystem::path::string_type, std::size_t> seen{};
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    auto base = entries[i].path.parent_path();
+    auto items = mugen::def::internal::palette_items(entries[i].def, std::make_index_sequence<mugen::def::PALETTE_SLOT_COUNT>{});
+    for (std::size_t slot = 0; slot < items.size(); ++slot) {
+      if (!*items[slot] || (*items[slot])->empty()) {
+        continue;
+      }
+      auto resolved = mugen::def::internal::resolve_def_path(base, **items[slot]).lexically_normal();
+      auto [it, inserted] = seen.emplace(resolved.native(), result.files.size());
+      if (inserted) {
+        result.files.push_back(std::move(resolved));
+      }
+      result.slots[i * mugen::def::PALETTE_SLOT_COUNT + slot] = it->second;
+    }
+  }
+
+  // 各ファイルは rgba 内の自分の領域に直接書き込むので、スレッド間で共有するものはない
+  result.rgba.resize(result.files.size() * mugen::def::RGBA_PALETTE_SIZE);
+  result.errors.resize(result.files.size());
+  mugen::def::internal::parallel_for(result.files.size(), jobs, [&](std::size_t i) {
+    std::span<std::uint8_t, mugen::def::RGBA_PALETTE_SIZE> rgba{result.rgba.data() + i * mugen::def::RGBA_PALETTE_SIZE,
+                                                                mugen::def::RGBA_PALETTE_SIZE};
+    try {
+      mugen::def::internal::read_act(result.files[i], rgba);
+    } catch (...) {
+      std::fill(rgba.begin(), rgba.end(), std::uint8_t{0});
+      result.errors[i] = std::current_exception();
+    }
+  });
+  return result;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file parallel.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_IMPL_PARALLEL_HPP__
+#define MDEFPARSER_IMPL_PARALLEL_HPP__
+
+#include "mdefparser/batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+static inline unsigned resolve_jobs(unsigned jobs, std::size_t count) noexcept {
+  if (jobs == 0) {
+    jobs = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return static_cast<unsigned>(std::min<std::size_t>(jobs, std::max<std::size_t>(count, 1)));
+}
+
+// [0, count) を jobs 本のスレッドで処理する (jobs == 0 の場合はハードウェアスレッド数)
+// 呼び出し元のスレッドもワーカーとして使用する
+template <class Function>
+static inline void parallel_for(std::size_t count, unsigned jobs, Function&& function) {
+  jobs = mugen::def::internal::resolve_jobs(jobs, count);
+  if (jobs <= 1) {
+    for (std::size_t i = 0; i < count; ++i) {
+      function(i);
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr error{};
+  std::mutex errorMutex{};
+
+  auto worker = [&]() {
+    try {
+      for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+        function(i);
+      }
+    } catch (...) {
+      std::lock_guard lock{errorMutex};
+      if (!error) {
+        error = std::current_exception();
+      }
+      next.store(count, std::memory_order_relaxed);
+    }
+  };
+
+  std::vector<std::thread> threads{};
+  threads.reserve(jobs - 1);
+  for (unsigned i = 1; i < jobs; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+template <class T, class Function>
+static inline mugen::def::BatchResult<T> capture_result(Function&& function) noexcept {
+  try {
+    return mugen::def::BatchResult<T>{.value = function(), .error = nullptr};
+  } catch (...) {
+    return mugen::def::BatchResult<T>{.value = std::nullopt, .error = std::current_exception()};
+  }
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_IMPL_PARALLEL_HPP__
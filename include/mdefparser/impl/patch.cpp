@@ -0,0 +1,286 @@
+/**
+ * @file patch.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/patch.hpp"
+#include "mdefparser/impl/file.hpp"
+#include "mdefparser/impl/line_reader.hpp"
+#include "mdefparser/impl/parallel.hpp"
+#include "mdefparser/impl/path.hpp"
+#include "mdefparser/impl/tokenizer.hpp"
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <utility>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+struct PatchLocation {
+  // 対象のセクションが見つかったか
+  bool hasSection;
+  // 値の位置 (項目がない場合は std::nullopt)
+  std::optional<std::pair<std::size_t, std::size_t>> value;
+  // 項目を追加する位置と、その前に改行が必要か
+  std::size_t insertAt;
+  bool needsNewline;
+};
+
+static inline std::string_view item_section(mugen::def::DefParseKey key) noexcept {
+  std::string_view section{};
+  mugen::def::for_each_key([&](auto item) {
+    if (item.value == key) {
+      section = mugen::def::DefItemType<item.value>::section;
+    }
+  });
+  return section;
+}
+
+// 最初の改行文字に揃える (改行がなければ CRLF)
+static inline std::string_view line_ending(std::string_view content) noexcept {
+  auto newline = content.find('\n');
+  if (newline != std::string_view::npos && (newline == 0 || content[newline - 1] != '\r')) {
+    return "\n";
+  }
+  return "\r\n";
+}
+
+static inline mugen::def::internal::PatchLocation locate_item(std::string_view content, mugen::def::DefParseKey key) {
+  auto section = mugen::def::internal::item_section(key);
+  auto name = mugen::def::key_name(key);
+
+  mugen::def::internal::PatchLocation location{.hasSection = false, .value = std::nullopt, .insertAt = content.size(), .needsNewline = false};
+
+  mugen::def::internal::MemoryFile file{content};
+  mugen::def::internal::BasicLineReader<mugen::def::internal::MemoryFile> reader{file};
+
+  bool inSection = false;
+  std::string_view rawLine{};
+  while (reader.next(rawLine)) {
+    auto offset = static_cast<std::size_t>(reader.line_offset());
+    auto line = mugen::def::internal::trim_view(rawLine);
+
+    if (!line.empty() && line.front() == '[') {
+      if (inSection) {
+        break;
+      }
+      if (mugen::def::internal::to_lower_ascii(line) == section) {
+        inSection = true;
+        location.hasSection = true;
+      } else {
+        continue;
+      }
+    } else if (!inSection || line.empty()) {
+      continue;
+    } else {
+      // DefParser と同様に key は最初の空白か '=' まで
+      auto delim = line.find_first_of(" \t=");
+      auto eqpos = line.find('=');
+      if (delim != std::string_view::npos && eqpos != std::string_view::npos &&
+          mugen::def::internal::iequals(line.substr(0, delim), name)) {
+        auto valueBegin = rawLine.find_first_not_of(" \t", rawLine.find('=') + 1);
+        auto comment = rawLine.find(';');
+        auto valueEnd = comment == std::string_view::npos ? rawLine.size() : comment;
+        if (valueBegin == std::string_view::npos || valueBegin > valueEnd) {
+          valueBegin = valueEnd;
+        }
+        while (valueEnd > valueBegin && (rawLine[valueEnd - 1] == ' ' || rawLine[valueEnd - 1] == '\t')) {
+          --valueEnd;
+        }
+        location.value = std::make_pair(offset + valueBegin, offset + valueEnd);
+        return location;
+      }
+    }
+
+    // セクションの最後の項目 (またはセクション名) の次の行に追加する
+    location.insertAt = static_cast<std::size_t>(reader.offset());
+    location.needsNewline = location.insertAt == content.size() && !content.empty() && content.back() != '\n';
+  }
+
+  if (!location.hasSection) {
+    location.insertAt = content.size();
+    location.needsNewline = !content.empty() && content.back() != '\n';
+  }
+  return location;
+}
+
+static inline void write_file_atomically(const std::filesystem::path& path, std::string_view data) {
+  static std::atomic<std::uint64_t> counter{std::random_device{}()};
+  auto temporary = path;
+  temporary += ".mdefparser-" + std::to_string(counter.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+
+#ifdef _WIN32
+  auto handle = ::CreateFileW(temporary.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (handle == INVALID_HANDLE_VALUE) {
+    throw mugen::def::FileIOError{"Can't create a temporary file."};
+  }
+
+  bool succeeded = true;
+  std::size_t written = 0;
+  while (succeeded && written < data.size()) {
+    DWORD request = static_cast<DWORD>(std::min<std::size_t>(data.size() - written, 0x40000000));
+    DWORD count = 0;
+    succeeded = ::WriteFile(handle, data.data() + written, request, &count, nullptr) != 0;
+    written += count;
+  }
+  succeeded = succeeded && ::FlushFileBuffers(handle);
+  ::CloseHandle(handle);
+
+  if (!succeeded || !::MoveFileExW(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+    ::DeleteFileW(temporary.c_str());
+    throw mugen::def::FileIOError{"Can't write the specified file."};
+  }
+#else
+  // 元のファイルがあれば権限を引き継ぐ
+  mode_t mode = 0644;
+  struct stat st;
+  if (::stat(path.c_str(), &st) == 0) {
+    mode = st.st_mode & 07777;
+  }
+
+  int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, mode);
+  if (fd < 0) {
+    throw mugen::def::FileIOError{"Can't create a temporary file."};
+  }
+
+  bool succeeded = ::fchmod(fd, mode) == 0;
+  std::size_t written = 0;
+  while (succeeded && written < data.size()) {
+    ssize_t count = ::write(fd, data.data() + written, data.size() - written);
+    if (count < 0) {
+      succeeded = errno == EINTR;
+      continue;
+    }
+    written += static_cast<std::size_t>(count);
+  }
+  succeeded = succeeded && ::fsync(fd) == 0;
+  succeeded = ::close(fd) == 0 && succeeded;
+
+  if (!succeeded || ::rename(temporary.c_str(), path.c_str()) != 0) {
+    ::unlink(temporary.c_str());
+    throw mugen::def::FileIOError{"Can't write the specified file."};
+  }
+#endif
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE mugen::def::DefPatcher::DefPatcher() noexcept : content_{}, modified_{false} {}
+
+MDEFPARSER_INLINE void mugen::def::DefPatcher::load(const std::filesystem::path& path) {
+  mugen::def::internal::ReadOnlyFile file{path};
+
+  std::string content(static_cast<std::size_t>(file.size()), '\0');
+  content.resize(file.read_at(0, content.data(), content.size()));
+  load_buffer(std::move(content));
+}
+
+MDEFPARSER_INLINE void mugen::def::DefPatcher::load_buffer(std::string content) {
+  content_ = std::move(content);
+  modified_ = false;
+}
+
+MDEFPARSER_INLINE std::optional<std::string_view> mugen::def::DefPatcher::raw_value(mugen::def::DefParseKey key) const {
+  auto location = mugen::def::internal::locate_item(content_, key);
+  if (!location.value) {
+    return std::nullopt;
+  }
+  auto [begin, end] = *location.value;
+  return std::string_view{content_}.substr(begin, end - begin);
+}
+
+MDEFPARSER_INLINE void mugen::def::DefPatcher::set_raw_value(mugen::def::DefParseKey key, std::string_view value) {
+  if (value.find_first_of("\r\n;") != std::string_view::npos) {
+    throw mugen::def::InvalidFormatError{"Value must not contain line breaks or comments."};
+  }
+
+  auto location = mugen::def::internal::locate_item(content_, key);
+  if (location.value) {
+    auto [begin, end] = *location.value;
+    if (std::string_view{content_}.substr(begin, end - begin) != value) {
+      content_.replace(begin, end - begin, value);
+      modified_ = true;
+    }
+    return;
+  }
+
+  auto newline = mugen::def::internal::line_ending(content_);
+  std::string inserted{};
+  if (location.needsNewline) {
+    inserted += newline;
+  }
+  if (!location.hasSection) {
+    // "[info]" などを "[Info]" の形で追加する
+    auto section = std::string{mugen::def::internal::item_section(key)};
+    section[1] = static_cast<char>(section[1] - 'a' + 'A');
+    inserted.append(section).append(newline);
+  }
+  inserted.append(mugen::def::key_name(key)).append(" = ").append(value).append(newline);
+
+  content_.insert(location.insertAt, inserted);
+  modified_ = true;
+}
+
+MDEFPARSER_INLINE void mugen::def::DefPatcher::set_value(mugen::def::DefParseKey key, std::string_view value) {
+  if (key == mugen::def::DefParseKey::Name || key == mugen::def::DefParseKey::DsiplayName || key == mugen::def::DefParseKey::Author) {
+    if (value.find('"') != std::string_view::npos) {
+      throw mugen::def::InvalidFormatError{"Quoted value must not contain quotes."};
+    }
+    set_raw_value(key, "\"" + std::string{value} + "\"");
+  } else {
+    set_raw_value(key, value);
+  }
+}
+
+MDEFPARSER_INLINE void mugen::def::DefPatcher::save(const std::filesystem::path& path) const {
+  mugen::def::internal::write_file_atomically(path, content_);
+}
+
+MDEFPARSER_INLINE std::vector<mugen::def::BatchResult<bool>> mugen::def::patch_batch(
+    std::span<const std::filesystem::path> paths,
+    const std::function<void(const std::filesystem::path&, mugen::def::DefPatcher&)>& edit,
+    unsigned jobs) {
+  std::vector<mugen::def::BatchResult<bool>> results(paths.size());
+  mugen::def::internal::parallel_for(paths.size(), jobs, [&](std::size_t i) {
+    results[i] = mugen::def::internal::capture_result<bool>([&]() {
+      mugen::def::DefPatcher patcher{};
+      patcher.load(paths[i]);
+      edit(paths[i], patcher);
+      if (!patcher.modified()) {
+        return false;
+      }
+      patcher.save(paths[i]);
+      return true;
+    });
+  });
+  return results;
+}
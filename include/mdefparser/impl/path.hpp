@@ -0,0 +1,183 @@
+/**
+ * @file path.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_IMPL_PATH_HPP__
+#define MDEFPARSER_IMPL_PATH_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+// パスを UTF-8 の '/' 区切りの文字列にする
+// def 内のパスは Windows 形式の区切り文字で書かれていることが多い
+static inline std::string to_generic_path(const std::filesystem::path& path) {
+  auto u8 = path.u8string();
+  std::string generic{reinterpret_cast<const char*>(u8.data()), u8.size()};
+  std::replace(generic.begin(), generic.end(), '\\', '/');
+  return generic;
+}
+
+// base / value (どちらも to_generic_path() で変換済み) を . と .. を取り除いた文字列にする
+// value が絶対パスの場合は base を無視する
+// std::filesystem::path::lexically_normal() は大量に呼び出すには遅いので文字列のまま処理する
+static inline std::string join_generic_path(std::string_view base, std::string_view value) {
+  std::string joined{value};
+  bool absolute = joined.starts_with('/') || (joined.size() >= 2 && joined[1] == ':');
+  if (!absolute && !base.empty()) {
+    joined = std::string{base} + '/' + joined;
+    absolute = joined.starts_with('/');
+  }
+
+  std::vector<std::string_view> segments{};
+  std::string_view rest{joined};
+  while (!rest.empty()) {
+    auto slash = rest.find('/');
+    auto segment = rest.substr(0, slash);
+    rest = slash == std::string_view::npos ? std::string_view{} : rest.substr(slash + 1);
+
+    if (segment.empty() || segment == ".") {
+      continue;
+    }
+    if (segment == ".." && !segments.empty() && segments.back() != "..") {
+      segments.pop_back();
+      continue;
+    }
+    if (segment == ".." && absolute) {
+      continue;
+    }
+    segments.push_back(segment);
+  }
+
+  std::string result = joined.starts_with('/') ? "/" : "";
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    if (i > 0) {
+      result += '/';
+    }
+    result += segments[i];
+  }
+  return result;
+}
+
+// ASCII の大文字を小文字にする
+static inline constexpr char to_lower_ascii(char c) noexcept {
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+static inline std::string to_lower_ascii(std::string_view value) {
+  std::string lowered{value};
+  for (auto& c : lowered) {
+    c = mugen::def::internal::to_lower_ascii(c);
+  }
+  return lowered;
+}
+
+// UTF-8 として正しいバイト列か
+// truncated の場合は末尾で途切れた文字も正しいものとみなす (前方一致で探す文字列など)
+static inline bool is_valid_utf8(std::string_view bytes, bool truncated = false) noexcept {
+  for (std::size_t i = 0; i < bytes.size();) {
+    auto c = static_cast<unsigned char>(bytes[i]);
+    std::size_t length = c < 0x80 ? 1 : (c & 0xE0) == 0xC0 ? 2 : (c & 0xF0) == 0xE0 ? 3 : (c & 0xF8) == 0xF0 ? 4 : 0;
+    if (length == 0 || (!truncated && bytes.size() - i < length)) {
+      return false;
+    }
+    length = std::min(length, bytes.size() - i);
+    for (std::size_t j = 1; j < length; ++j) {
+      if ((static_cast<unsigned char>(bytes[i + j]) & 0xC0) != 0x80) {
+        return false;
+      }
+    }
+    i += length;
+  }
+  return true;
+}
+
+// bytes[i] から CP932 の 2 バイト文字が始まるか
+static inline bool is_cp932_pair(std::string_view bytes, std::size_t i) noexcept {
+  if (i + 1 >= bytes.size()) {
+    return false;
+  }
+  auto lead = static_cast<unsigned char>(bytes[i]);
+  auto trail = static_cast<unsigned char>(bytes[i + 1]);
+  return ((lead >= 0x81 && lead <= 0x9F) || (lead >= 0xE0 && lead <= 0xFC)) &&
+         ((trail >= 0x40 && trail <= 0x7E) || (trail >= 0x80 && trail <= 0xFC));
+}
+
+// ASCII の大文字を小文字にしながら 1 バイトずつ返す
+// utf8 でない場合は CP932 とみなし、2 バイト文字は (2 バイト目が英字や 0x5C でも) そのまま返す
+// CP932 で 2 バイト目が ASCII となる文字列は UTF-8 として正しくないので、文字コードは is_valid_utf8() で判定できる
+class AsciiFolder {
+ public:
+  explicit AsciiFolder(std::string_view bytes, bool utf8) noexcept : bytes_{bytes}, index_{0}, cp932_{!utf8}, multibyte_{false}, trail_{false} {}
+  explicit AsciiFolder(std::string_view bytes) noexcept : AsciiFolder{bytes, mugen::def::internal::is_valid_utf8(bytes)} {}
+
+  bool done() const noexcept {
+    return index_ >= bytes_.size();
+  }
+
+  char next() noexcept {
+    auto c = bytes_[index_];
+    if (trail_) {
+      trail_ = false;
+    } else if (cp932_ && mugen::def::internal::is_cp932_pair(bytes_, index_)) {
+      multibyte_ = trail_ = true;
+    } else {
+      multibyte_ = false;
+      c = mugen::def::internal::to_lower_ascii(c);
+    }
+    ++index_;
+    return c;
+  }
+
+  // 直前に返したバイトが CP932 の 2 バイト文字の一部か
+  bool multibyte() const noexcept {
+    return multibyte_;
+  }
+
+ private:
+  std::string_view bytes_;
+  std::size_t index_;
+  bool cp932_;
+  bool multibyte_;
+  bool trail_;
+};
+
+// AsciiFolder で小文字にした文字列
+static inline std::string fold_ascii(std::string_view value) {
+  std::string folded{};
+  folded.reserve(value.size());
+  for (mugen::def::internal::AsciiFolder folder{value}; !folder.done();) {
+    folded += folder.next();
+  }
+  return folded;
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_IMPL_PATH_HPP__
@@ -0,0 +1,151 @@
+/**
+ * @file portable_file.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_IMPL_PORTABLE_FILE_HPP__
+#define MDEFPARSER_IMPL_PORTABLE_FILE_HPP__
+
+#include "mdefparser/mdefparser.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+// <cstdio> のみで読み込む読み取り専用ファイル
+// ヘッダーオンリーで FileSource を指定しない場合に使い、windows.h などを読み込まずに済ませる
+// ReadOnlyFile と異なり、1 つのスレッドからのみ読み込める
+class StdioFile {
+ public:
+  StdioFile(const StdioFile&) = delete;
+  StdioFile& operator=(const StdioFile&) = delete;
+
+  explicit StdioFile(const std::filesystem::path& path) : file_{nullptr}, size_{0}, position_{0} {
+    std::error_code ec{};
+    if (!std::filesystem::is_regular_file(path, ec)) {
+      throw mugen::def::FileIOError{"Can't find the specified file."};
+    }
+    size_ = std::filesystem::file_size(path, ec);
+    if (ec) {
+      throw mugen::def::FileIOError{"Can't get the size of the specified file."};
+    }
+
+#ifdef _WIN32
+    file_ = ::_wfopen(path.c_str(), L"rb");
+#else
+    file_ = std::fopen(path.c_str(), "rb");
+#endif
+    if (!file_) {
+      throw mugen::def::FileIOError{"Can't open the specified file."};
+    }
+    // 呼び出し元のバッファに直接読み込む
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+  }
+
+  ~StdioFile() {
+    std::fclose(file_);
+  }
+
+  std::uint64_t size() const noexcept {
+    return size_;
+  }
+
+  // 読み込めたバイト数を返す (EOF に達した場合は length 未満)
+  std::size_t read_at(std::uint64_t offset, void* buffer, std::size_t length) const {
+    if (offset != position_) {
+#ifdef _WIN32
+      bool sought = ::_fseeki64(file_, static_cast<long long>(offset), SEEK_SET) == 0;
+#else
+      bool sought = ::fseeko(file_, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+      if (!sought) {
+        throw mugen::def::FileIOError{"Can't read the specified file."};
+      }
+      position_ = offset;
+    }
+
+    auto read = std::fread(buffer, 1, length, file_);
+    if (read < length && std::ferror(file_)) {
+      throw mugen::def::FileIOError{"Can't read the specified file."};
+    }
+    position_ += read;
+    return read;
+  }
+
+ private:
+  std::FILE* file_;
+  std::uint64_t size_;
+  mutable std::uint64_t position_;
+};
+
+// メモリ上のデータを ReadOnlyFile と同じ形で読み込む
+class MemoryFile {
+ public:
+  MemoryFile(const MemoryFile&) = delete;
+  MemoryFile& operator=(const MemoryFile&) = delete;
+
+  explicit MemoryFile(std::string_view data) noexcept : data_{data} {}
+
+  std::uint64_t size() const noexcept {
+    return data_.size();
+  }
+
+  std::string_view data() const noexcept {
+    return data_;
+  }
+
+  std::size_t read_at(std::uint64_t offset, void* buffer, std::size_t length) const noexcept {
+    if (offset >= data_.size()) {
+      return 0;
+    }
+    auto count = std::min<std::size_t>(length, data_.size() - static_cast<std::size_t>(offset));
+    std::memcpy(buffer, data_.data() + offset, count);
+    return count;
+  }
+
+ private:
+  std::string_view data_;
+};
+
+// def 内に書かれた相対パスを def のあるフォルダ base から解決する
+// Windows 形式の区切り文字はどのプラットフォームでも区切り文字として扱う
+static inline std::filesystem::path resolve_def_path(const std::filesystem::path& base, const std::filesystem::path& value) {
+#ifdef _WIN32
+  return base / value;
+#else
+  auto generic = value.native();
+  std::replace(generic.begin(), generic.end(), '\\', '/');
+  return base / generic;
+#endif
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_IMPL_PORTABLE_FILE_HPP__
@@ -0,0 +1,287 @@
+/**
+ * @file scan.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/scan.hpp"
+#include "mdefparser/impl/mpmc_queue.hpp"
+#include "mdefparser/impl/parallel.hpp"
+#include "mdefparser/impl/tokenizer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+struct LocalityKey {
+  std::uint64_t device;
+  std::uint64_t directory;
+  std::uint64_t inode;
+  std::size_t index;
+
+  bool operator<(const LocalityKey& other) const noexcept {
+    return std::tie(device, directory, inode, index) < std::tie(other.device, other.directory, other.inode, other.index);
+  }
+};
+
+// ページキャッシュへの先読みを要求する (読み込みの完了は待たない)
+static inline void advise_willneed([[maybe_unused]] const std::filesystem::path& path) noexcept {
+#if !defined(_WIN32) && defined(POSIX_FADV_WILLNEED)
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return;
+  }
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+  ::close(fd);
+#endif
+}
+
+// root 以下の .def ファイルを見つけた順に function(path) に渡す
+// function が false を返した場合はそこで打ち切る
+template <class Function>
+static inline void for_each_def_file(const std::filesystem::path& root, Function&& function) {
+  std::error_code ec{};
+  if (std::filesystem::is_regular_file(root, ec)) {
+    function(root);
+    return;
+  }
+  if (!std::filesystem::is_directory(root, ec)) {
+    throw mugen::def::FileIOError{"Can't find the specified directory."};
+  }
+
+  auto options = std::filesystem::directory_options::skip_permission_denied;
+  for (auto it = std::filesystem::recursive_directory_iterator{root, options, ec}; !ec && it != std::filesystem::recursive_directory_iterator{};
+       it.increment(ec)) {
+    if (!it->is_regular_file(ec)) {
+      continue;
+    }
+
+    auto extension = it->path().extension().string();
+    if (mugen::def::internal::iequals(extension, ".def") && !function(it->path())) {
+      return;
+    }
+  }
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE std::vector<std::filesystem::path> mugen::def::find_def_files(const std::filesystem::path& root) {
+  std::vector<std::filesystem::path> paths{};
+  mugen::def::internal::for_each_def_file(root, [&](const std::filesystem::path& path) {
+    paths.push_back(path);
+    return true;
+  });
+
+  std::sort(paths.begin(), paths.end());
+  return paths;
+}
+
+MDEFPARSER_INLINE std::vector<std::size_t> mugen::def::locality_order(std::span<const std::filesystem::path> paths) {
+  constexpr auto unknown = std::numeric_limits<std::uint64_t>::max();
+
+  std::vector<mugen::def::internal::LocalityKey> keys{};
+  keys.reserve(paths.size());
+
+  // 同じフォルダのファイルは続けて現れることが多いので、フォルダの情報は一度だけ取得する
+  std::unordered_map<std::string, std::uint64_t> directories{};
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    auto parent = paths[i].parent_path().string();
+    auto [it, inserted] = directories.try_emplace(parent, unknown);
+#ifdef _WIN32
+    if (inserted) {
+      it->second = directories.size();
+    }
+    keys.push_back(mugen::def::internal::LocalityKey{.device = 0, .directory = it->second, .inode = 0, .index = i});
+#else
+    if (inserted) {
+      struct stat st;
+      if (::stat(parent.empty() ? "." : parent.c_str(), &st) == 0) {
+        it->second = static_cast<std::uint64_t>(st.st_ino);
+      }
+    }
+
+    struct stat st;
+    if (::stat(paths[i].c_str(), &st) != 0) {
+      keys.push_back(mugen::def::internal::LocalityKey{.device = unknown, .directory = unknown, .inode = unknown, .index = i});
+      continue;
+    }
+    keys.push_back(mugen::def::internal::LocalityKey{.device = static_cast<std::uint64_t>(st.st_dev),
+                                                     .directory = it->second,
+                                                     .inode = static_cast<std::uint64_t>(st.st_ino),
+                                                     .index = i});
+#endif
+  }
+
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<std::size_t> order(keys.size());
+  std::transform(keys.begin(), keys.end(), order.begin(), [](const auto& key) { return key.index; });
+  return order;
+}
+
+MDEFPARSER_INLINE void mugen::def::parse_in_locality_order(
+    std::span<const std::filesystem::path> paths,
+    mugen::def::DefParserWin& parser,
+    const std::function<void(std::size_t, mugen::def::BatchResult<mugen::def::MugenDefWin>&&)>& callback,
+    unsigned jobs,
+    std::size_t readahead) {
+  auto order = mugen::def::locality_order(paths);
+
+  // 先読みはいずれか 1 つのスレッドがまとめて行う
+  std::atomic<std::size_t> prefetched{0};
+  std::mutex prefetchMutex{};
+
+  mugen::def::internal::parallel_for(order.size(), jobs, [&](std::size_t k) {
+    if (readahead > 0 && k + readahead / 2 >= prefetched.load(std::memory_order_relaxed)) {
+      std::unique_lock lock{prefetchMutex, std::try_to_lock};
+      if (lock) {
+        auto begin = std::max(prefetched.load(std::memory_order_relaxed), k);
+        auto end = std::min(order.size(), k + readahead);
+        for (auto j = begin; j < end; ++j) {
+          mugen::def::internal::advise_willneed(paths[order[j]]);
+        }
+        prefetched.store(std::max(begin, end), std::memory_order_relaxed);
+      }
+    }
+
+    auto i = order[k];
+    callback(i, mugen::def::internal::capture_result<mugen::def::MugenDefWin>([&]() { return parser.parse(paths[i]); }));
+  });
+}
+
+struct mugen::def::ScanStream::State {
+  State(mugen::def::DefParserWin&& parser, std::size_t capacity)
+      : parser{std::move(parser)}, paths{capacity}, results{capacity}, threads{}, running{0} {}
+
+  // 破棄された場合は残りを打ち切り、すべてのスレッドの終了を待つ
+  ~State() {
+    paths.cancel();
+    results.cancel();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  mugen::def::DefParserWin parser;
+  mugen::def::internal::MpmcQueue<std::filesystem::path> paths;
+  mugen::def::internal::MpmcQueue<mugen::def::ScanItem> results;
+  std::vector<std::thread> threads;
+  std::atomic<unsigned> running;
+};
+
+MDEFPARSER_INLINE mugen::def::ScanStream::ScanStream(std::unique_ptr<State> state) noexcept : state_{std::move(state)}, current_{} {}
+
+MDEFPARSER_INLINE mugen::def::ScanStream::ScanStream(ScanStream&&) noexcept = default;
+
+MDEFPARSER_INLINE mugen::def::ScanStream& mugen::def::ScanStream::operator=(ScanStream&&) noexcept = default;
+
+MDEFPARSER_INLINE mugen::def::ScanStream::~ScanStream() = default;
+
+MDEFPARSER_INLINE mugen::def::ScanStream::iterator mugen::def::ScanStream::begin() {
+  if (!current_) {
+    next();
+  }
+  return iterator{this};
+}
+
+MDEFPARSER_INLINE void mugen::def::ScanStream::next() {
+  mugen::def::ScanItem item{};
+  if (state_ && state_->results.pop(item)) {
+    current_ = std::move(item);
+  } else {
+    current_.reset();
+  }
+}
+
+MDEFPARSER_INLINE mugen::def::ScanStream mugen::def::scan_stream(const std::filesystem::path& root, unsigned jobs, std::size_t capacity) {
+  return mugen::def::scan_stream(root, mugen::def::DefParserWin{}, jobs, capacity);
+}
+
+MDEFPARSER_INLINE mugen::def::ScanStream mugen::def::scan_stream(const std::filesystem::path& root,
+                                                                 mugen::def::DefParserWin&& parser,
+                                                                 unsigned jobs,
+                                                                 std::size_t capacity) {
+  // root の誤りはスレッドを起動する前に報告する
+  std::error_code ec{};
+  if (!std::filesystem::is_regular_file(root, ec) && !std::filesystem::is_directory(root, ec)) {
+    throw mugen::def::FileIOError{"Can't find the specified directory."};
+  }
+
+  auto state = std::make_unique<mugen::def::ScanStream::State>(std::move(parser), capacity);
+  auto* shared = state.get();
+
+  jobs = mugen::def::internal::resolve_jobs(jobs, std::numeric_limits<std::size_t>::max());
+  shared->running.store(jobs, std::memory_order_relaxed);
+  shared->threads.reserve(jobs + 1);
+
+  shared->threads.emplace_back([shared, root]() {
+    try {
+      mugen::def::internal::for_each_def_file(root, [shared](const std::filesystem::path& path) {
+        return shared->paths.push(std::filesystem::path{path});
+      });
+    } catch (...) {
+      // 走査中に root が消えた場合などは見つかった分のみを返す
+    }
+    shared->paths.close();
+  });
+
+  for (unsigned i = 0; i < jobs; ++i) {
+    shared->threads.emplace_back([shared]() {
+      std::filesystem::path path{};
+      while (shared->paths.pop(path)) {
+        auto result = mugen::def::internal::capture_result<mugen::def::MugenDefWin>([&]() { return shared->parser.parse(path); });
+        if (!shared->results.push(mugen::def::ScanItem{.path = std::move(path), .result = std::move(result)})) {
+          break;
+        }
+      }
+      // 最後に終わったスレッドが結果の終わりを通知する
+      if (shared->running.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        shared->results.close();
+      }
+    });
+  }
+
+  return mugen::def::ScanStream{std::move(state)};
+}
@@ -0,0 +1,142 @@
+/**
+ * @file select.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/select.hpp"
+#include "mdefparser/impl/file.hpp"
+#include "mdefparser/impl/line_reader.hpp"
+#include "mdefparser/impl/parallel.hpp"
+#include "mdefparser/impl/path.hpp"
+#include "mdefparser/impl/tokenizer.hpp"
+
+#include <string_view>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+static inline std::filesystem::path resolve_select_character(const std::filesystem::path& mugenRoot, std::string_view name) {
+  auto chars = mugenRoot / "chars";
+  if (mugen::def::internal::to_lower_ascii(name).ends_with(".def")) {
+    return mugen::def::internal::resolve_def_path(chars, std::string{name});
+  }
+  auto folder = mugen::def::internal::resolve_def_path(chars, std::string{name});
+  return folder / (folder.filename().string() + ".def");
+}
+
+static inline mugen::def::SelectCharacter parse_select_character(std::string_view line, const std::filesystem::path& mugenRoot) {
+  mugen::def::SelectCharacter character{.name = {}, .randomSelect = false, .stage = std::nullopt, .options = {}, .defPath = std::nullopt};
+
+  std::size_t field = 0;
+  while (true) {
+    auto delim = line.find(',');
+    auto value = mugen::def::internal::trim_view(line.substr(0, delim));
+
+    if (field == 0) {
+      character.name = std::string{value};
+    } else if (auto keyValue = mugen::def::internal::split_key_value(value)) {
+      character.options.emplace_back(mugen::def::internal::to_lower_ascii((*keyValue)[0]), std::string{(*keyValue)[1]});
+    } else if (field == 1 && !value.empty()) {
+      character.stage = std::filesystem::path{std::string{value}};
+    }
+    ++field;
+
+    if (delim == std::string_view::npos) {
+      break;
+    }
+    line.remove_prefix(delim + 1);
+  }
+
+  character.randomSelect = mugen::def::internal::iequals(character.name, "randomselect");
+  if (!character.randomSelect) {
+    character.defPath = mugen::def::internal::resolve_select_character(mugenRoot, character.name);
+  }
+  return character;
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE mugen::def::SelectParser::SelectParser() noexcept {}
+
+MDEFPARSER_INLINE mugen::def::SelectDef mugen::def::SelectParser::parse(const std::filesystem::path& path) {
+  return parse(path, path.parent_path().parent_path());
+}
+
+MDEFPARSER_INLINE mugen::def::SelectDef mugen::def::SelectParser::parse(const std::filesystem::path& path, const std::filesystem::path& mugenRoot) {
+  mugen::def::internal::ReadOnlyFile file{path};
+  mugen::def::internal::LineReader reader{file};
+
+  enum class Section { Other, Characters, ExtraStages };
+  auto section = Section::Other;
+
+  mugen::def::SelectDef select{};
+  std::string_view rawLine{};
+  while (reader.next(rawLine)) {
+    auto line = mugen::def::internal::trim_view(rawLine);
+    if (line.empty()) {
+      continue;
+    }
+
+    if (auto name = mugen::def::internal::section_name(line)) {
+      if (mugen::def::internal::iequals(*name, "characters")) {
+        section = Section::Characters;
+      } else if (mugen::def::internal::iequals(*name, "extrastages")) {
+        section = Section::ExtraStages;
+      } else {
+        section = Section::Other;
+      }
+      continue;
+    }
+
+    if (section == Section::Characters) {
+      auto character = mugen::def::internal::parse_select_character(line, mugenRoot);
+      if (!character.name.empty()) {
+        select.characters.push_back(std::move(character));
+      }
+    } else if (section == Section::ExtraStages) {
+      select.extraStages.emplace_back(std::string{line});
+    }
+  }
+
+  return select;
+}
+
+MDEFPARSER_INLINE std::vector<mugen::def::BatchResult<mugen::def::MugenDefWin>> mugen::def::load_roster(const mugen::def::SelectDef& select,
+                                                                                                       mugen::def::DefParserWin& parser,
+                                                                                                       unsigned jobs) {
+  std::vector<mugen::def::BatchResult<mugen::def::MugenDefWin>> results(select.characters.size());
+  mugen::def::internal::parallel_for(select.characters.size(), jobs, [&](std::size_t i) {
+    const auto& character = select.characters[i];
+    if (character.defPath) {
+      results[i] = mugen::def::internal::capture_result<mugen::def::MugenDefWin>([&]() { return parser.parse(*character.defPath); });
+    }
+  });
+  return results;
+}
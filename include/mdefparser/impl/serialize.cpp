@@ -0,0 +1,339 @@
+/**
+ * @file serialize.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/serialize.hpp"
+#include "mdefparser/impl/binary.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+static inline constexpr std::size_t SERIALIZE_HEADER_SIZE = 20;
+static inline constexpr std::uint64_t SERIALIZE_INTRO_STORYBOARD_BIT = std::uint64_t{1} << mugen::def::DefParseKeyCount;
+static inline constexpr std::uint64_t SERIALIZE_ENDING_STORYBOARD_BIT = std::uint64_t{1} << (mugen::def::DefParseKeyCount + 1);
+
+static_assert(mugen::def::DefParseKeyCount + 2 <= 64);
+
+// 書き込み先の大きさを数えるだけの Writer
+class SizeCounter {
+ public:
+  void u8(std::uint8_t) noexcept {
+    size_ += 1;
+  }
+  void u32(std::uint32_t) noexcept {
+    size_ += 4;
+  }
+  void i32(std::int32_t) noexcept {
+    size_ += 4;
+  }
+  void bytes(const void*, std::size_t length) noexcept {
+    size_ += length;
+  }
+
+  std::size_t size() const noexcept {
+    return size_;
+  }
+
+ private:
+  std::size_t size_ = 0;
+};
+
+class SpanWriter {
+ public:
+  explicit SpanWriter(std::byte* data) noexcept : data_{data}, pos_{0} {}
+
+  void u8(std::uint8_t value) noexcept {
+    data_[pos_++] = static_cast<std::byte>(value);
+  }
+  void u32(std::uint32_t value) noexcept {
+    mugen::def::internal::store_le(&data_[pos_], value);
+    pos_ += 4;
+  }
+  void i32(std::int32_t value) noexcept {
+    mugen::def::internal::store_le(&data_[pos_], value);
+    pos_ += 4;
+  }
+  void bytes(const void* src, std::size_t length) noexcept {
+    std::memcpy(&data_[pos_], src, length);
+    pos_ += length;
+  }
+
+  std::size_t size() const noexcept {
+    return pos_;
+  }
+
+ private:
+  std::byte* data_;
+  std::size_t pos_;
+};
+
+class SpanReader {
+ public:
+  explicit SpanReader(std::span<const std::byte> data) noexcept : data_{data}, pos_{0} {}
+
+  const std::byte* take(std::size_t length) {
+    if (length > data_.size() - pos_) {
+      throw mugen::def::InvalidFormatError{"Serialized data is truncated."};
+    }
+    const std::byte* p = &data_[pos_];
+    pos_ += length;
+    return p;
+  }
+
+  std::uint8_t u8() {
+    return static_cast<std::uint8_t>(*take(1));
+  }
+  std::uint32_t u32() {
+    return mugen::def::internal::load_le<std::uint32_t>(take(4));
+  }
+  std::int32_t i32() {
+    return mugen::def::internal::load_le<std::int32_t>(take(4));
+  }
+  std::string_view str() {
+    auto length = u32();
+    return std::string_view{reinterpret_cast<const char*>(take(length)), length};
+  }
+
+  std::size_t pos() const noexcept {
+    return pos_;
+  }
+
+ private:
+  std::span<const std::byte> data_;
+  std::size_t pos_;
+};
+
+template <class Writer>
+static inline void write_string(Writer& writer, std::string_view value) {
+  if (value.size() > std::numeric_limits<std::uint32_t>::max()) {
+    throw mugen::def::InvalidFormatError{"String is too long to serialize."};
+  }
+  writer.u32(static_cast<std::uint32_t>(value.size()));
+  writer.bytes(value.data(), value.size());
+}
+
+template <class Writer>
+static inline void write_value(Writer& writer, const std::string& value) {
+  mugen::def::internal::write_string(writer, value);
+}
+
+template <class Writer>
+static inline void write_value(Writer& writer, const std::filesystem::path& value) {
+  auto u8 = value.u8string();
+  mugen::def::internal::write_string(writer, std::string_view{reinterpret_cast<const char*>(u8.data()), u8.size()});
+}
+
+template <class Writer>
+static inline void write_value(Writer& writer, const mugen::def::MugenDefVersion& value) {
+  writer.i32(value.month);
+  writer.i32(value.day);
+  writer.i32(value.year);
+}
+
+template <class Writer>
+static inline void write_value(Writer& writer, const std::vector<std::int32_t>& value) {
+  auto count = static_cast<std::uint8_t>(std::min<std::size_t>(value.size(), std::numeric_limits<std::uint8_t>::max()));
+  writer.u8(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    writer.i32(value[i]);
+  }
+}
+
+template <class Writer>
+static inline void write_value(Writer& writer, const mugen::def::StoryboardDef& value) {
+  mugen::def::internal::write_value(writer, value.sprite);
+  writer.u8(value.sound ? 1 : 0);
+  if (value.sound) {
+    mugen::def::internal::write_value(writer, *value.sound);
+  }
+  writer.u32(static_cast<std::uint32_t>(std::min<std::size_t>(value.sceneCount, std::numeric_limits<std::uint32_t>::max())));
+}
+
+static inline std::uint64_t presence_bits(const mugen::def::MugenDefWin& def) noexcept {
+  std::uint64_t presence = 0;
+  mugen::def::for_each_key([&](auto key) {
+    if constexpr (mugen::def::is_required_item<key.value>) {
+      presence |= std::uint64_t{1} << static_cast<std::size_t>(key.value);
+    } else if (mugen::def::get_item<key.value>(def)) {
+      presence |= std::uint64_t{1} << static_cast<std::size_t>(key.value);
+    }
+  });
+  if (def.arcade.introStoryboard) {
+    presence |= SERIALIZE_INTRO_STORYBOARD_BIT;
+  }
+  if (def.arcade.endingStoryboard) {
+    presence |= SERIALIZE_ENDING_STORYBOARD_BIT;
+  }
+  return presence;
+}
+
+template <class Writer>
+static inline void write_def(Writer& writer, const mugen::def::MugenDefWin& def, std::uint32_t size) {
+  writer.bytes("MDEF", 4);
+  writer.u8(mugen::def::SerializeFormatVersion);
+  writer.u8(0);
+  writer.u8(0);
+  writer.u8(0);
+  writer.u32(size);
+
+  auto presence = mugen::def::internal::presence_bits(def);
+  writer.u32(static_cast<std::uint32_t>(presence));
+  writer.u32(static_cast<std::uint32_t>(presence >> 32));
+
+  mugen::def::for_each_key([&](auto key) {
+    const auto& item = mugen::def::get_item<key.value>(def);
+    if constexpr (mugen::def::is_required_item<key.value>) {
+      mugen::def::internal::write_value(writer, item);
+    } else if (item) {
+      mugen::def::internal::write_value(writer, *item);
+    }
+  });
+
+  if (def.arcade.introStoryboard) {
+    mugen::def::internal::write_value(writer, *def.arcade.introStoryboard);
+  }
+  if (def.arcade.endingStoryboard) {
+    mugen::def::internal::write_value(writer, *def.arcade.endingStoryboard);
+  }
+}
+
+template <class T>
+static inline T read_value(SpanReader& reader) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string{reader.str()};
+  } else if constexpr (std::is_same_v<T, std::filesystem::path>) {
+    auto value = reader.str();
+    return std::filesystem::path{std::u8string_view{reinterpret_cast<const char8_t*>(value.data()), value.size()}};
+  } else if constexpr (std::is_same_v<T, mugen::def::MugenDefVersion>) {
+    auto month = reader.i32();
+    auto day = reader.i32();
+    auto year = reader.i32();
+    return mugen::def::MugenDefVersion{.month = month, .day = day, .year = year};
+  } else if constexpr (std::is_same_v<T, std::vector<std::int32_t>>) {
+    std::vector<std::int32_t> values(reader.u8());
+    for (auto& value : values) {
+      value = reader.i32();
+    }
+    return values;
+  } else {
+    static_assert(std::is_same_v<T, mugen::def::StoryboardDef>);
+    auto sprite = mugen::def::internal::read_value<std::filesystem::path>(reader);
+    std::optional<std::filesystem::path> sound{};
+    if (reader.u8()) {
+      sound = mugen::def::internal::read_value<std::filesystem::path>(reader);
+    }
+    auto sceneCount = reader.u32();
+    return mugen::def::StoryboardDef{.sprite = std::move(sprite), .sound = std::move(sound), .sceneCount = sceneCount};
+  }
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE std::size_t mugen::def::serialized_size(const mugen::def::MugenDefWin& def) {
+  mugen::def::internal::SizeCounter counter{};
+  mugen::def::internal::write_def(counter, def, 0);
+  return counter.size();
+}
+
+MDEFPARSER_INLINE std::size_t mugen::def::serialize(const mugen::def::MugenDefWin& def, std::span<std::byte> out) {
+  auto size = mugen::def::serialized_size(def);
+  if (size > out.size()) {
+    throw mugen::def::InsufficientBufferError{"Output buffer is too small."};
+  }
+  if (size > std::numeric_limits<std::uint32_t>::max()) {
+    throw mugen::def::InvalidFormatError{"Definition is too large to serialize."};
+  }
+
+  mugen::def::internal::SpanWriter writer{out.data()};
+  mugen::def::internal::write_def(writer, def, static_cast<std::uint32_t>(size));
+  return writer.size();
+}
+
+MDEFPARSER_INLINE mugen::def::MugenDefWin mugen::def::deserialize(std::span<const std::byte> in, std::size_t* consumed) {
+  mugen::def::internal::SpanReader reader{in};
+
+  if (std::memcmp(reader.take(4), "MDEF", 4) != 0) {
+    throw mugen::def::InvalidFormatError{"Serialized data has invalid signature."};
+  }
+  if (reader.u8() != mugen::def::SerializeFormatVersion) {
+    throw mugen::def::InvalidFormatError{"Unsupported serialized format version."};
+  }
+  reader.take(3);
+
+  auto size = reader.u32();
+  if (size > in.size() || size < mugen::def::internal::SERIALIZE_HEADER_SIZE) {
+    throw mugen::def::InvalidFormatError{"Serialized data is truncated."};
+  }
+  reader = mugen::def::internal::SpanReader{in.first(size)};
+  reader.take(mugen::def::internal::SERIALIZE_HEADER_SIZE - 8);
+
+  std::uint64_t presence = reader.u32();
+  presence |= static_cast<std::uint64_t>(reader.u32()) << 32;
+
+  mugen::def::MugenDefWin def{};
+  mugen::def::for_each_key([&](auto key) {
+    using type = typename mugen::def::DefItemType<key.value>::type;
+    bool present = (presence >> static_cast<std::size_t>(key.value)) & 1;
+    if constexpr (mugen::def::is_required_item<key.value>) {
+      if (!present) {
+        throw mugen::def::MissingKeyError{"Required parameter does not exist."};
+      }
+      mugen::def::get_item<key.value>(def) = mugen::def::internal::read_value<type>(reader);
+    } else if (present) {
+      mugen::def::get_item<key.value>(def) = mugen::def::internal::read_value<type>(reader);
+    }
+  });
+
+  if (presence & mugen::def::internal::SERIALIZE_INTRO_STORYBOARD_BIT) {
+    def.arcade.introStoryboard = mugen::def::internal::read_value<mugen::def::StoryboardDef>(reader);
+  }
+  if (presence & mugen::def::internal::SERIALIZE_ENDING_STORYBOARD_BIT) {
+    def.arcade.endingStoryboard = mugen::def::internal::read_value<mugen::def::StoryboardDef>(reader);
+  }
+
+  if (reader.pos() != size) {
+    throw mugen::def::InvalidFormatError{"Serialized data has trailing bytes."};
+  }
+  if (consumed) {
+    *consumed = size;
+  }
+  return def;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file sff.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/sff.hpp"
+#include "mdefparser/impl/binary.hpp"
+#include "mdefparser/impl/file.hpp"
+#include "mdefparser/impl/parallel.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+struct SffRawSprite {
+  std::uint16_t group;
+  std::uint16_t index;
+  std::uint16_t linked;
+  std::uint32_t offset;
+  std::uint32_t length;
+};
+
+static inline constexpr std::size_t SFF_HEADER_SIZE = 0x48;
+static inline constexpr std::size_t SFF_V1_SUBHEADER_SIZE = 32;
+static inline constexpr std::size_t SFF_V2_SPRITE_NODE_SIZE = 28;
+
+static inline std::vector<SffRawSprite> read_sff_v1_directory(const ReadOnlyFile& file, const unsigned char* header) {
+  auto numImages = mugen::def::internal::load_le<std::uint32_t>(&header[20]);
+  auto offset = static_cast<std::uint64_t>(mugen::def::internal::load_le<std::uint32_t>(&header[24]));
+
+  // v1 はサブファイルが連結リストになっているため、サブヘッダーを 1 つずつ辿る
+  std::vector<SffRawSprite> raw{};
+  raw.reserve(std::min<std::uint64_t>(numImages, file.size() / SFF_V1_SUBHEADER_SIZE));
+
+  unsigned char subheader[SFF_V1_SUBHEADER_SIZE];
+  for (std::uint32_t i = 0; i < numImages; ++i) {
+    if (offset == 0 || offset + SFF_V1_SUBHEADER_SIZE > file.size()) {
+      break;
+    }
+    if (file.read_at(offset, subheader, sizeof(subheader)) != sizeof(subheader)) {
+      throw mugen::def::InvalidFormatError{"SFF subfile header is truncated."};
+    }
+
+    auto next = static_cast<std::uint64_t>(mugen::def::internal::load_le<std::uint32_t>(&subheader[0]));
+    raw.push_back(SffRawSprite{.group = mugen::def::internal::load_le<std::uint16_t>(&subheader[12]),
+                               .index = mugen::def::internal::load_le<std::uint16_t>(&subheader[14]),
+                               .linked = mugen::def::internal::load_le<std::uint16_t>(&subheader[16]),
+                               .offset = static_cast<std::uint32_t>(offset + SFF_V1_SUBHEADER_SIZE),
+                               .length = mugen::def::internal::load_le<std::uint32_t>(&subheader[4])});
+
+    // 循環したリストで無限ループしないよう、後方へのリンクのみ辿る
+    if (next <= offset) {
+      break;
+    }
+    offset = next;
+  }
+
+  return raw;
+}
+
+static inline std::vector<SffRawSprite> read_sff_v2_directory(const ReadOnlyFile& file, const unsigned char* header) {
+  auto nodeOffset = static_cast<std::uint64_t>(mugen::def::internal::load_le<std::uint32_t>(&header[0x24]));
+  auto numSprites = static_cast<std::uint64_t>(mugen::def::internal::load_le<std::uint32_t>(&header[0x28]));
+  auto ldataOffset = mugen::def::internal::load_le<std::uint32_t>(&header[0x34]);
+  auto tdataOffset = mugen::def::internal::load_le<std::uint32_t>(&header[0x3C]);
+
+  if (nodeOffset + numSprites * SFF_V2_SPRITE_NODE_SIZE > file.size()) {
+    throw mugen::def::InvalidFormatError{"SFF sprite directory is truncated."};
+  }
+
+  // v2 はスプライトノードが連続しているため 1 回の読み込みで済む
+  std::vector<unsigned char> nodes(static_cast<std::size_t>(numSprites * SFF_V2_SPRITE_NODE_SIZE));
+  if (file.read_at(nodeOffset, nodes.data(), nodes.size()) != nodes.size()) {
+    throw mugen::def::InvalidFormatError{"SFF sprite directory is truncated."};
+  }
+
+  std::vector<SffRawSprite> raw{};
+  raw.reserve(static_cast<std::size_t>(numSprites));
+  for (std::size_t i = 0; i < nodes.size(); i += SFF_V2_SPRITE_NODE_SIZE) {
+    const unsigned char* node = &nodes[i];
+    auto flags = mugen::def::internal::load_le<std::uint16_t>(&node[26]);
+    auto base = (flags & 1) ? tdataOffset : ldataOffset;
+    raw.push_back(SffRawSprite{.group = mugen::def::internal::load_le<std::uint16_t>(&node[0]),
+                               .index = mugen::def::internal::load_le<std::uint16_t>(&node[2]),
+                               .linked = mugen::def::internal::load_le<std::uint16_t>(&node[12]),
+                               .offset = base + mugen::def::internal::load_le<std::uint32_t>(&node[16]),
+                               .length = mugen::def::internal::load_le<std::uint32_t>(&node[20])});
+  }
+
+  return raw;
+}
+
+static inline std::vector<mugen::def::SffSprite> build_sff_table(const std::vector<SffRawSprite>& raw) {
+  std::vector<mugen::def::SffSprite> sprites{};
+  sprites.reserve(raw.size());
+
+  for (const auto& sprite : raw) {
+    // データ長 0 のスプライトは linked 番目のスプライトのデータを共有する
+    const SffRawSprite* target = &sprite;
+    for (std::size_t depth = 0; target->length == 0 && target->linked < raw.size() && depth < raw.size(); ++depth) {
+      if (&raw[target->linked] == target) {
+        break;
+      }
+      target = &raw[target->linked];
+    }
+    sprites.push_back(mugen::def::SffSprite{.group = sprite.group, .index = sprite.index, .offset = target->offset, .length = target->length});
+  }
+
+  auto less = [](const mugen::def::SffSprite& a, const mugen::def::SffSprite& b) {
+    return a.group != b.group ? a.group < b.group : a.index < b.index;
+  };
+  auto equal = [](const mugen::def::SffSprite& a, const mugen::def::SffSprite& b) { return a.group == b.group && a.index == b.index; };
+
+  std::stable_sort(sprites.begin(), sprites.end(), less);
+  sprites.erase(std::unique(sprites.begin(), sprites.end(), equal), sprites.end());
+  sprites.shrink_to_fit();
+
+  return sprites;
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE const mugen::def::SffSprite* mugen::def::SffIndex::find(std::uint16_t group, std::uint16_t index) const noexcept {
+  auto it = std::partition_point(sprites.begin(), sprites.end(), [group, index](const mugen::def::SffSprite& sprite) {
+    return sprite.group < group || (sprite.group == group && sprite.index < index);
+  });
+  if (it == sprites.end() || it->group != group || it->index != index) {
+    return nullptr;
+  }
+  return &*it;
+}
+
+MDEFPARSER_INLINE std::size_t mugen::def::SffIndex::count(std::uint16_t group) const noexcept {
+  auto first = std::partition_point(sprites.begin(), sprites.end(), [group](const mugen::def::SffSprite& sprite) { return sprite.group < group; });
+  auto last = std::partition_point(first, sprites.end(), [group](const mugen::def::SffSprite& sprite) { return sprite.group <= group; });
+  return static_cast<std::size_t>(last - first);
+}
+
+MDEFPARSER_INLINE mugen::def::SffReader::SffReader() noexcept {}
+
+MDEFPARSER_INLINE mugen::def::SffIndex mugen::def::SffReader::read_index(const std::filesystem::path& path) {
+  mugen::def::internal::ReadOnlyFile file{path};
+
+  unsigned char header[mugen::def::internal::SFF_HEADER_SIZE]{};
+  auto read = file.read_at(0, header, sizeof(header));
+  if (read < 32 || std::memcmp(header, "ElecbyteSpr\0", 12) != 0) {
+    throw mugen::def::InvalidFormatError{"The specified file is not SFF."};
+  }
+
+  std::vector<mugen::def::internal::SffRawSprite> raw{};
+  std::uint8_t version = header[15];
+  if (version == 1) {
+    raw = mugen::def::internal::read_sff_v1_directory(file, header);
+  } else if (version == 2) {
+    if (read < sizeof(header)) {
+      throw mugen::def::InvalidFormatError{"SFF header is truncated."};
+    }
+    raw = mugen::def::internal::read_sff_v2_directory(file, header);
+  } else {
+    throw mugen::def::InvalidFormatError{"Unsupported SFF version."};
+  }
+
+  return mugen::def::SffIndex{
+      .version = version, .spriteCount = static_cast<std::uint32_t>(raw.size()), .sprites = mugen::def::internal::build_sff_table(raw)};
+}
+
+MDEFPARSER_INLINE std::vector<mugen::def::BatchResult<mugen::def::SffIndex>> mugen::def::SffReader::read_index_batch(
+    std::span<const std::filesystem::path> paths,
+    unsigned jobs) {
+  std::vector<mugen::def::BatchResult<mugen::def::SffIndex>> results(paths.size());
+  mugen::def::internal::parallel_for(paths.size(), jobs, [&](std::size_t i) {
+    results[i] = mugen::def::internal::capture_result<mugen::def::SffIndex>([&]() { return read_index(paths[i]); });
+  });
+  return results;
+}
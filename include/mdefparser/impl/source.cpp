@@ -0,0 +1,272 @@
+/**
+ * @file source.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/source.hpp"
+#include "mdefparser/impl/file.hpp"
+#include "mdefparser/impl/path.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+class PreadFileHandle : public mugen::def::FileHandle {
+ public:
+  explicit PreadFileHandle(const std::filesystem::path& path) : file_{path} {}
+
+  std::uint64_t size() const noexcept override {
+    return file_.size();
+  }
+
+  std::size_t read_at(std::uint64_t offset, void* buffer, std::size_t length) const override {
+    return file_.read_at(offset, buffer, length);
+  }
+
+ private:
+  mugen::def::internal::ReadOnlyFile file_;
+};
+
+class MmapFileHandle : public mugen::def::FileHandle {
+ public:
+  MmapFileHandle(const MmapFileHandle&) = delete;
+  MmapFileHandle& operator=(const MmapFileHandle&) = delete;
+
+  explicit MmapFileHandle(const std::filesystem::path& path) : data_{nullptr}, size_{0} {
+#ifdef _WIN32
+    auto file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      throw mugen::def::FileIOError{"Can't open the specified file."};
+    }
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size)) {
+      ::CloseHandle(file);
+      throw mugen::def::FileIOError{"Can't get the size of the specified file."};
+    }
+    size_ = static_cast<std::uint64_t>(size.QuadPart);
+
+    // 空のファイルはマップできない
+    if (size_ > 0) {
+      auto mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping) {
+        data_ = static_cast<const char*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        ::CloseHandle(mapping);
+      }
+      if (!data_) {
+        ::CloseHandle(file);
+        throw mugen::def::FileIOError{"Can't map the specified file."};
+      }
+    }
+    ::CloseHandle(file);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw mugen::def::FileIOError{"Can't open the specified file."};
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+      ::close(fd);
+      throw mugen::def::FileIOError{"Can't find the specified file."};
+    }
+    size_ = static_cast<std::uint64_t>(st.st_size);
+
+    // 空のファイルはマップできない
+    if (size_ > 0) {
+      auto* mapped = ::mmap(nullptr, static_cast<std::size_t>(size_), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped == MAP_FAILED) {
+        ::close(fd);
+        throw mugen::def::FileIOError{"Can't map the specified file."};
+      }
+      data_ = static_cast<const char*>(mapped);
+    }
+    ::close(fd);
+#endif
+  }
+
+  ~MmapFileHandle() override {
+    if (!data_) {
+      return;
+    }
+#ifdef _WIN32
+    ::UnmapViewOfFile(data_);
+#else
+    ::munmap(const_cast<char*>(data_), static_cast<std::size_t>(size_));
+#endif
+  }
+
+  std::uint64_t size() const noexcept override {
+    return size_;
+  }
+
+  std::size_t read_at(std::uint64_t offset, void* buffer, std::size_t length) const override {
+    if (offset >= size_) {
+      return 0;
+    }
+    auto count = static_cast<std::size_t>(std::min<std::uint64_t>(length, size_ - offset));
+    std::memcpy(buffer, data_ + offset, count);
+    return count;
+  }
+
+  std::optional<std::string_view> contiguous() const noexcept override {
+    return std::string_view{data_, static_cast<std::size_t>(size_)};
+  }
+
+ private:
+  const char* data_;
+  std::uint64_t size_;
+};
+
+class MemoryFileHandle : public mugen::def::FileHandle {
+ public:
+  MemoryFileHandle(std::shared_ptr<const std::string> owner, std::string_view data) noexcept : owner_{std::move(owner)}, file_{data} {}
+
+  std::uint64_t size() const noexcept override {
+    return file_.size();
+  }
+
+  std::size_t read_at(std::uint64_t offset, void* buffer, std::size_t length) const override {
+    return file_.read_at(offset, buffer, length);
+  }
+
+  std::optional<std::string_view> contiguous() const noexcept override {
+    return file_.data();
+  }
+
+ private:
+  std::shared_ptr<const std::string> owner_;
+  mugen::def::internal::MemoryFile file_;
+};
+
+static inline std::optional<mugen::def::FileStat> to_file_stat(const std::optional<mugen::def::internal::FileStamp>& stamp) noexcept {
+  if (!stamp) {
+    return std::nullopt;
+  }
+  return mugen::def::FileStat{.size = stamp->size, .modified = stamp->modified};
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE std::optional<mugen::def::FileStat> mugen::def::PreadFileSource::stat(const std::filesystem::path& path) const {
+  return mugen::def::internal::to_file_stat(mugen::def::internal::stat_file(path));
+}
+
+MDEFPARSER_INLINE std::unique_ptr<mugen::def::FileHandle> mugen::def::PreadFileSource::open(const std::filesystem::path& path) const {
+  return std::make_unique<mugen::def::internal::PreadFileHandle>(path);
+}
+
+MDEFPARSER_INLINE std::optional<mugen::def::FileStat> mugen::def::MmapFileSource::stat(const std::filesystem::path& path) const {
+  return mugen::def::internal::to_file_stat(mugen::def::internal::stat_file(path));
+}
+
+MDEFPARSER_INLINE std::unique_ptr<mugen::def::FileHandle> mugen::def::MmapFileSource::open(const std::filesystem::path& path) const {
+  return std::make_unique<mugen::def::internal::MmapFileHandle>(path);
+}
+
+MDEFPARSER_INLINE mugen::def::MemoryFileSource::MemoryFileSource() noexcept : mutex_{}, entries_{}, revision_{0} {}
+
+MDEFPARSER_INLINE void mugen::def::MemoryFileSource::add(const std::filesystem::path& path, std::string content) {
+  auto owner = std::make_shared<const std::string>(std::move(content));
+  std::string_view data{*owner};
+  insert(path, Entry{.owner = std::move(owner), .data = data, .modified = 0});
+}
+
+MDEFPARSER_INLINE void mugen::def::MemoryFileSource::add_view(const std::filesystem::path& path, std::string_view content) {
+  insert(path, Entry{.owner = nullptr, .data = content, .modified = 0});
+}
+
+MDEFPARSER_INLINE void mugen::def::MemoryFileSource::insert(const std::filesystem::path& path, Entry&& entry) {
+  auto key = mugen::def::internal::join_generic_path({}, mugen::def::internal::to_generic_path(path));
+
+  std::unique_lock lock{mutex_};
+  // 同じパスに登録し直した場合も変更を検出できるようにする
+  entry.modified = ++revision_;
+  entries_.insert_or_assign(std::move(key), std::move(entry));
+}
+
+MDEFPARSER_INLINE void mugen::def::MemoryFileSource::remove(const std::filesystem::path& path) {
+  auto key = mugen::def::internal::join_generic_path({}, mugen::def::internal::to_generic_path(path));
+
+  std::unique_lock lock{mutex_};
+  entries_.erase(key);
+}
+
+MDEFPARSER_INLINE std::optional<mugen::def::FileStat> mugen::def::MemoryFileSource::stat(const std::filesystem::path& path) const {
+  auto key = mugen::def::internal::join_generic_path({}, mugen::def::internal::to_generic_path(path));
+
+  std::shared_lock lock{mutex_};
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  return mugen::def::FileStat{.size = it->second.data.size(), .modified = it->second.modified};
+}
+
+MDEFPARSER_INLINE std::unique_ptr<mugen::def::FileHandle> mugen::def::MemoryFileSource::open(const std::filesystem::path& path) const {
+  auto key = mugen::def::internal::join_generic_path({}, mugen::def::internal::to_generic_path(path));
+
+  std::shared_lock lock{mutex_};
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    throw mugen::def::FileIOError{"Can't find the specified file."};
+  }
+  return std::make_unique<mugen::def::internal::MemoryFileHandle>(it->second.owner, it->second.data);
+}
+
+MDEFPARSER_INLINE mugen::def::OverlayFileSource::OverlayFileSource(std::vector<std::shared_ptr<const mugen::def::FileSource>> layers) noexcept
+    : layers_{std::move(layers)} {}
+
+MDEFPARSER_INLINE std::optional<mugen::def::FileStat> mugen::def::OverlayFileSource::stat(const std::filesystem::path& path) const {
+  for (const auto& layer : layers_) {
+    if (auto stat = layer->stat(path)) {
+      return stat;
+    }
+  }
+  return std::nullopt;
+}
+
+MDEFPARSER_INLINE std::unique_ptr<mugen::def::FileHandle> mugen::def::OverlayFileSource::open(const std::filesystem::path& path) const {
+  for (const auto& layer : layers_) {
+    if (layer->stat(path)) {
+      return layer->open(path);
+    }
+  }
+  throw mugen::def::FileIOError{"Can't find the specified file."};
+}
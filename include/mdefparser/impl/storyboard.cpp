@@ -0,0 +1,39 @@
+/**
+ * @file storyboard.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/storyboard.hpp"
+#include "mdefparser/impl/file.hpp"
+#include "mdefparser/impl/storyboard.hpp"
+
+MDEFPARSER_INLINE mugen::def::StoryboardParser::StoryboardParser() noexcept {}
+
+MDEFPARSER_INLINE mugen::def::StoryboardDef mugen::def::StoryboardParser::parse(const std::filesystem::path& path) {
+  mugen::def::internal::ReadOnlyFile file{path};
+  return mugen::def::internal::parse_storyboard(file);
+}
@@ -0,0 +1,100 @@
+/**
+ * @file storyboard.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_IMPL_STORYBOARD_HPP__
+#define MDEFPARSER_IMPL_STORYBOARD_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/impl/line_reader.hpp"
+#include "mdefparser/impl/tokenizer.hpp"
+
+#include <cctype>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+// Source は size() と read_at() を持つもの (ReadOnlyFile, MemoryFile, FileHandle)
+template <class Source>
+static inline mugen::def::StoryboardDef parse_storyboard(const Source& file) {
+  mugen::def::internal::BasicLineReader<Source> reader{file};
+
+  bool inSceneDef = false;
+  bool hasSceneDef = false;
+
+  std::optional<std::filesystem::path> sprite{};
+  std::optional<std::filesystem::path> sound{};
+  std::size_t sceneCount = 0;
+
+  std::string buffer{};
+  std::string_view rawLine{};
+  while (reader.next(rawLine)) {
+    buffer.assign(rawLine);
+    auto line = mugen::def::internal::trimline(buffer.data());
+    if (line[0] == '[') {
+      inSceneDef = false;
+
+      mugen::def::internal::tolowers(line);
+      if (!hasSceneDef && std::strcmp(line.c_str(), "[scenedef]") == 0) {
+        inSceneDef = true;
+        hasSceneDef = true;
+      } else if (std::strncmp(line.c_str(), "[scene", 6) == 0 && (line[6] == ' ' || std::isdigit(static_cast<unsigned char>(line[6])))) {
+        // [Scene 0], [Scene 1], ... の数を数える
+        ++sceneCount;
+      }
+      continue;
+    }
+
+    if (inSceneDef) {
+      auto result = mugen::def::internal::get_key_value(line);
+      if (result) {
+        auto key = (*result)[0];
+        auto value = (*result)[1];
+
+        if (std::strcmp(key.data(), "spr") == 0) {
+          if (!sprite) {
+            sprite = value;
+          }
+        } else if (std::strcmp(key.data(), "snd") == 0) {
+          if (!sound) {
+            sound = value;
+          }
+        }
+      }
+    }
+  }
+
+  if (!sprite) {
+    throw mugen::def::MissingKeyError{"Required parameter does not exist."};
+  }
+
+  return mugen::def::StoryboardDef{.sprite = *sprite, .sound = sound, .sceneCount = sceneCount};
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_IMPL_STORYBOARD_HPP__
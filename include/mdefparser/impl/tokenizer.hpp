@@ -0,0 +1,262 @@
+/**
+ * @file tokenizer.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_IMPL_TOKENIZER_HPP__
+#define MDEFPARSER_IMPL_TOKENIZER_HPP__
+
+#include "mdefparser/mdefparser.h"
+
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+using namespace std::string_view_literals;
+
+static inline void tolowers(std::string& str, size_t count = std::string::npos) noexcept {
+  if (count == std::string::npos) {
+    count = str.size();
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    str[i] = static_cast<char>(std::tolower(str[i]));
+  }
+}
+
+static inline std::string trimline(char* line) noexcept {
+  // Remove comment
+  char* p = std::strchr(line, ';');
+  if (p) {
+    *p = '\0';
+  }
+
+  // ltrim
+  size_t len = std::strlen(line);
+  size_t start = std::strspn(line, " \t\n");
+  if (start > 0) {
+    std::memmove(line, &line[start], len + 1 - start);
+    len -= start;
+  }
+
+  // rtrim
+  char c;
+  while (len > 0 && ((c = line[len - 1]) == ' ' || c == '\t' || c == '\n')) {
+    line[len - 1] = '\0';
+    --len;
+  }
+
+  return std::string(line, len + 1);
+}
+
+static inline std::optional<std::array<std::string_view, 2>> get_key_value(std::string& line) noexcept {
+  // 文字「=」、文字「 」がKeyの中に含まれるケースは想定しない
+
+  size_t delim = line.find_first_of(" \t\n=");
+  if (delim == std::string::npos) {
+    return std::nullopt;
+  }
+
+  // 「=」の位置を特定
+  size_t eqpos = delim;
+  if (line[eqpos] != '=') {
+    eqpos = line.find_first_of('=');
+    if (eqpos == std::string::npos) {
+      return std::nullopt;
+    }
+  }
+
+  // 元の文字列を Key と Value で分割
+  line.data()[delim] = '\0';
+
+  // key は小文字化して返却
+  mugen::def::internal::tolowers(line, delim);
+  std::string_view key(line.data(), delim + 1);
+
+  // value のみ見つからない場合は 空文字列 を返させる
+  size_t offset = line.find_first_not_of(" \t\n", eqpos + 1);
+  if (offset == std::string::npos) {
+    return std::make_optional<std::array<std::string_view, 2>>({key, ""sv});
+  }
+
+  std::string_view value(&line.data()[offset]);
+  return std::make_optional<std::array<std::string_view, 2>>({key, value});
+}
+
+static inline std::optional<std::string_view> dequote_string(std::string_view value) noexcept {
+  size_t len = value.size();
+  if (value[0] == '\"' && value[len - 1] == '\"') {
+    return value.substr(1, len - 2);
+  } else {
+    return std::nullopt;
+  }
+}
+
+static inline mugen::def::MugenDefVersion convert_to_version(std::string_view value) noexcept {
+  std::array<std::int32_t, 3> mdy{0, 0, 0};
+
+  size_t start = 0;
+  size_t cnt = 0;
+  while (cnt < 3) {
+    size_t last = value.find_first_of(',', start);
+    try {
+      mdy[cnt] = std::stoi(std::string{value.substr(start, last - start)});
+    } catch (...) {
+      break;
+    }
+
+    if (last == std::string_view::npos) {
+      break;
+    }
+    start = last + 1;
+    ++cnt;
+  }
+
+  return mugen::def::MugenDefVersion{.month = mdy[0], .day = mdy[1], .year = mdy[2]};
+}
+
+static inline std::vector<std::int32_t> parse_pal_defaults(std::string_view value) noexcept {
+  // pal.defaults は 先頭4つのみ有効なので、
+  // 最大長は4とする
+
+  // 途中で数字以外が出現した場合はそこで打ち切り
+  // 例) 1, 2, foo, 3 => {1, 2}
+
+  std::vector<std::int32_t> vec{};
+
+  size_t start = 0;
+  while (vec.size() < 4) {
+    size_t last = value.find_first_of(',', start);
+    try {
+      vec.push_back(std::stoi(std::string{value.substr(start, last - start)}));
+    } catch (...) {
+      return vec;
+    }
+
+    if (last == std::string_view::npos) {
+      break;
+    }
+    start = last + 1;
+  }
+
+  return vec;
+}
+
+// 以下は行を書き換えずに std::string_view のまま扱う版
+
+static inline std::string_view trim_view(std::string_view line) noexcept {
+  // Remove comment
+  size_t comment = line.find(';');
+  if (comment != std::string_view::npos) {
+    line = line.substr(0, comment);
+  }
+
+  size_t start = line.find_first_not_of(" \t\r\n");
+  if (start == std::string_view::npos) {
+    return std::string_view{};
+  }
+  size_t last = line.find_last_not_of(" \t\r\n");
+  return line.substr(start, last + 1 - start);
+}
+
+static inline bool iequals(std::string_view a, std::string_view b) noexcept {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static inline bool istarts_with(std::string_view str, std::string_view prefix) noexcept {
+  return str.size() >= prefix.size() && mugen::def::internal::iequals(str.substr(0, prefix.size()), prefix);
+}
+
+static inline std::optional<std::array<std::string_view, 2>> split_key_value(std::string_view line) noexcept {
+  size_t eqpos = line.find('=');
+  if (eqpos == std::string_view::npos) {
+    return std::nullopt;
+  }
+
+  auto key = mugen::def::internal::trim_view(line.substr(0, eqpos));
+  auto value = mugen::def::internal::trim_view(line.substr(eqpos + 1));
+  return std::make_optional<std::array<std::string_view, 2>>({key, value});
+}
+
+// "[Begin Action 100]" から "Begin Action 100" を取り出す
+static inline std::optional<std::string_view> section_name(std::string_view line) noexcept {
+  if (line.size() < 2 || line.front() != '[') {
+    return std::nullopt;
+  }
+
+  size_t close = line.find(']');
+  if (close == std::string_view::npos) {
+    close = line.size();
+  }
+  return mugen::def::internal::trim_view(line.substr(1, close - 1));
+}
+
+template <class T>
+static inline std::optional<T> parse_number(std::string_view value) noexcept {
+  value = mugen::def::internal::trim_view(value);
+  if (!value.empty() && value.front() == '+') {
+    value.remove_prefix(1);
+  }
+
+  T number{};
+  auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+  if (ec != std::errc{} || ptr != value.data() + value.size()) {
+    return std::nullopt;
+  }
+  return number;
+}
+
+// カンマ区切りの値を最大 N 個まで分割する
+template <size_t N>
+static inline size_t split_values(std::string_view value, std::array<std::string_view, N>& out) noexcept {
+  size_t count = 0;
+  while (count < N) {
+    size_t delim = value.find(',');
+    out[count++] = mugen::def::internal::trim_view(value.substr(0, delim));
+    if (delim == std::string_view::npos) {
+      break;
+    }
+    value.remove_prefix(delim + 1);
+  }
+  return count;
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_IMPL_TOKENIZER_HPP__
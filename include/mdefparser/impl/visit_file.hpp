@@ -0,0 +1,68 @@
+/**
+ * @file visit_file.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_IMPL_VISIT_FILE_HPP__
+#define MDEFPARSER_IMPL_VISIT_FILE_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/file_source.hpp"
+
+// ヘッダーオンリーではプラットフォームのヘッダーを読み込まないように <cstdio> で読み込む
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/portable_file.hpp"
+#else
+#include "mdefparser/impl/file.hpp"
+#endif
+
+#include <filesystem>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+#ifdef MDEFPARSER_HEADER_ONLY
+using DirectFile = mugen::def::internal::StdioFile;
+#else
+using DirectFile = mugen::def::internal::ReadOnlyFile;
+#endif
+
+// source が nullptr の場合はファイルを直接読み込む
+// 内容全体がメモリ上にある場合はそれを直接読む
+template <class Function>
+static inline decltype(auto) visit_file(const mugen::def::FileSource* source, const std::filesystem::path& path, Function&& function) {
+  if (!source) {
+    mugen::def::internal::DirectFile file{path};
+    return function(file);
+  }
+
+  auto handle = source->open(path);
+  if (auto data = handle->contiguous()) {
+    mugen::def::internal::MemoryFile file{*data};
+    return function(file);
+  }
+  return function(*handle);
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_IMPL_VISIT_FILE_HPP__
@@ -0,0 +1,148 @@
+/**
+ * @file xxhash.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_IMPL_XXHASH_HPP__
+#define MDEFPARSER_IMPL_XXHASH_HPP__
+
+#include "mdefparser/impl/binary.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+// XXH64 (https://github.com/Cyan4973/xxHash) の逐次計算
+class Xxh64 {
+ public:
+  explicit Xxh64(std::uint64_t seed = 0) noexcept
+      : acc_{seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1}, seed_{seed}, totalLength_{0}, buffer_{}, bufferSize_{0} {}
+
+  void update(const void* data, std::size_t length) noexcept {
+    auto* input = static_cast<const unsigned char*>(data);
+    totalLength_ += length;
+
+    if (bufferSize_ + length < 32) {
+      std::memcpy(buffer_.data() + bufferSize_, input, length);
+      bufferSize_ += length;
+      return;
+    }
+
+    if (bufferSize_ > 0) {
+      auto fill = 32 - bufferSize_;
+      std::memcpy(buffer_.data() + bufferSize_, input, fill);
+      consume(buffer_.data());
+      input += fill;
+      length -= fill;
+      bufferSize_ = 0;
+    }
+
+    while (length >= 32) {
+      consume(input);
+      input += 32;
+      length -= 32;
+    }
+
+    std::memcpy(buffer_.data(), input, length);
+    bufferSize_ = length;
+  }
+
+  std::uint64_t digest() const noexcept {
+    std::uint64_t hash;
+    if (totalLength_ >= 32) {
+      hash = std::rotl(acc_[0], 1) + std::rotl(acc_[1], 7) + std::rotl(acc_[2], 12) + std::rotl(acc_[3], 18);
+      for (auto acc : acc_) {
+        hash = merge_round(hash, acc);
+      }
+    } else {
+      hash = seed_ + PRIME5;
+    }
+    hash += totalLength_;
+
+    const auto* p = buffer_.data();
+    auto remaining = bufferSize_;
+    while (remaining >= 8) {
+      hash ^= round(0, mugen::def::internal::load_le<std::uint64_t>(p));
+      hash = std::rotl(hash, 27) * PRIME1 + PRIME4;
+      p += 8;
+      remaining -= 8;
+    }
+    if (remaining >= 4) {
+      hash ^= static_cast<std::uint64_t>(mugen::def::internal::load_le<std::uint32_t>(p)) * PRIME1;
+      hash = std::rotl(hash, 23) * PRIME2 + PRIME3;
+      p += 4;
+      remaining -= 4;
+    }
+    while (remaining > 0) {
+      hash ^= *p * PRIME5;
+      hash = std::rotl(hash, 11) * PRIME1;
+      ++p;
+      --remaining;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+
+ private:
+  static constexpr std::uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+  static constexpr std::uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+  static constexpr std::uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+  static constexpr std::uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+  static constexpr std::uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+  static std::uint64_t round(std::uint64_t acc, std::uint64_t input) noexcept {
+    acc += input * PRIME2;
+    acc = std::rotl(acc, 31);
+    return acc * PRIME1;
+  }
+
+  static std::uint64_t merge_round(std::uint64_t hash, std::uint64_t acc) noexcept {
+    hash ^= round(0, acc);
+    return hash * PRIME1 + PRIME4;
+  }
+
+  void consume(const unsigned char* stripe) noexcept {
+    for (std::size_t i = 0; i < 4; ++i) {
+      acc_[i] = round(acc_[i], mugen::def::internal::load_le<std::uint64_t>(stripe + i * 8));
+    }
+  }
+
+  std::array<std::uint64_t, 4> acc_;
+  std::uint64_t seed_;
+  std::uint64_t totalLength_;
+  std::array<unsigned char, 32> buffer_;
+  std::size_t bufferSize_;
+};
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+#endif  // MDEFPARSER_IMPL_XXHASH_HPP__
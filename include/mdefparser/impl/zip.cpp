@@ -0,0 +1,334 @@
+/**
+ * @file zip.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INLINE
+#ifdef MDEFPARSER_HEADER_ONLY
+#define MDEFPARSER_INLINE inline
+#else
+#define MDEFPARSER_INLINE
+#endif
+#endif
+
+#include "mdefparser/zip.hpp"
+#include "mdefparser/impl/binary.hpp"
+#include "mdefparser/impl/file.hpp"
+#include "mdefparser/impl/parallel.hpp"
+#include "mdefparser/impl/path.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace mugen {
+namespace def {
+namespace internal {
+
+static inline constexpr std::uint32_t ZIP_LOCAL_HEADER_SIGNATURE = 0x04034b50;
+static inline constexpr std::uint32_t ZIP_CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+static inline constexpr std::uint32_t ZIP_EOCD_SIGNATURE = 0x06054b50;
+static inline constexpr std::uint32_t ZIP64_EOCD_SIGNATURE = 0x06064b50;
+static inline constexpr std::uint32_t ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+
+static inline constexpr std::size_t ZIP_LOCAL_HEADER_SIZE = 30;
+static inline constexpr std::size_t ZIP_CENTRAL_HEADER_SIZE = 46;
+static inline constexpr std::size_t ZIP_EOCD_SIZE = 22;
+static inline constexpr std::size_t ZIP64_EOCD_SIZE = 56;
+static inline constexpr std::size_t ZIP64_LOCATOR_SIZE = 20;
+
+static inline std::string read_zip_bytes(const mugen::def::internal::ReadOnlyFile& file, std::uint64_t offset, std::uint64_t length) {
+  if (offset > file.size() || length > file.size() - offset) {
+    throw mugen::def::InvalidFormatError{"Zip archive is truncated."};
+  }
+
+  std::string bytes(static_cast<std::size_t>(length), '\0');
+  if (file.read_at(offset, bytes.data(), bytes.size()) != bytes.size()) {
+    throw mugen::def::InvalidFormatError{"Zip archive is truncated."};
+  }
+  return bytes;
+}
+
+static inline constexpr std::uint16_t ZIP_FLAG_UTF8 = 0x0800;
+
+// 名前をバイト列のまま '/' 区切りにして ASCII を小文字にする
+// utf8 でない場合は CP932 とみなし、2 バイト文字の 2 バイト目 (0x5C や英字を含む) は書き換えない
+// CP932 で 2 バイト目が 0x5C となる名前は UTF-8 として正しくないので、フラグのない名前は UTF-8 として正しいかで判定する
+static inline std::string zip_generic_name(std::string_view name, bool utf8) {
+  std::string generic{};
+  generic.reserve(name.size());
+  for (mugen::def::internal::AsciiFolder folder{name, utf8}; !folder.done();) {
+    auto c = folder.next();
+    generic += c == '\\' && !folder.multibyte() ? '/' : c;
+  }
+  return generic;
+}
+
+static inline std::string zip_generic_name(std::string_view name) {
+  return mugen::def::internal::zip_generic_name(name, mugen::def::internal::is_valid_utf8(name));
+}
+
+static inline std::string zip_generic_name(const mugen::def::ZipEntry& entry) {
+  return mugen::def::internal::zip_generic_name(entry.name, (entry.flags & ZIP_FLAG_UTF8) || mugen::def::internal::is_valid_utf8(entry.name));
+}
+
+// ZIP64 拡張フィールドは 0xFFFFFFFF となっている項目のみをこの順に持つ
+static inline void apply_zip64_extra(mugen::def::ZipEntry& entry, std::string_view extra) {
+  while (extra.size() >= 4) {
+    auto id = mugen::def::internal::load_le<std::uint16_t>(extra.data());
+    auto size = mugen::def::internal::load_le<std::uint16_t>(extra.data() + 2);
+    if (size > extra.size() - 4) {
+      break;
+    }
+
+    if (id == 0x0001) {
+      auto field = extra.substr(4, size);
+      auto take = [&field](std::uint64_t& value) {
+        if (value == 0xFFFFFFFF) {
+          if (field.size() < 8) {
+            throw mugen::def::InvalidFormatError{"Zip64 extra field is truncated."};
+          }
+          value = mugen::def::internal::load_le<std::uint64_t>(field.data());
+          field.remove_prefix(8);
+        }
+      };
+      take(entry.uncompressedSize);
+      take(entry.compressedSize);
+      take(entry.localHeaderOffset);
+      return;
+    }
+    extra.remove_prefix(4 + size);
+  }
+}
+
+};  // namespace internal
+};  // namespace def
+};  // namespace mugen
+
+MDEFPARSER_INLINE mugen::def::ZipArchive::ZipArchive(const std::filesystem::path& path)
+    : file_{std::make_unique<mugen::def::internal::ReadOnlyFile>(path)}, entries_{}, lookup_{} {
+  const auto& file = *file_;
+
+  // 終端レコードはコメント (最大 0xFFFF バイト) の直前にある
+  auto tailSize = std::min<std::uint64_t>(file.size(), mugen::def::internal::ZIP_EOCD_SIZE + 0xFFFF);
+  auto tail = mugen::def::internal::read_zip_bytes(file, file.size() - tailSize, tailSize);
+
+  std::size_t eocd = std::string::npos;
+  for (std::size_t i = tail.size() >= mugen::def::internal::ZIP_EOCD_SIZE ? tail.size() - mugen::def::internal::ZIP_EOCD_SIZE + 1 : 0; i-- > 0;) {
+    if (mugen::def::internal::load_le<std::uint32_t>(tail.data() + i) == mugen::def::internal::ZIP_EOCD_SIGNATURE) {
+      eocd = i;
+      break;
+    }
+  }
+  if (eocd == std::string::npos) {
+    throw mugen::def::InvalidFormatError{"Zip end of central directory record is not found."};
+  }
+
+  std::uint64_t entryCount = mugen::def::internal::load_le<std::uint16_t>(tail.data() + eocd + 10);
+  std::uint64_t directorySize = mugen::def::internal::load_le<std::uint32_t>(tail.data() + eocd + 12);
+  std::uint64_t directoryOffset = mugen::def::internal::load_le<std::uint32_t>(tail.data() + eocd + 16);
+
+  if (entryCount == 0xFFFF || directorySize == 0xFFFFFFFF || directoryOffset == 0xFFFFFFFF) {
+    auto eocdOffset = file.size() - tailSize + eocd;
+    if (eocdOffset < mugen::def::internal::ZIP64_LOCATOR_SIZE) {
+      throw mugen::def::InvalidFormatError{"Zip64 locator is not found."};
+    }
+    auto locator = mugen::def::internal::read_zip_bytes(file, eocdOffset - mugen::def::internal::ZIP64_LOCATOR_SIZE,
+                                                        mugen::def::internal::ZIP64_LOCATOR_SIZE);
+    if (mugen::def::internal::load_le<std::uint32_t>(locator.data()) != mugen::def::internal::ZIP64_LOCATOR_SIGNATURE) {
+      throw mugen::def::InvalidFormatError{"Zip64 locator is not found."};
+    }
+
+    auto record = mugen::def::internal::read_zip_bytes(file, mugen::def::internal::load_le<std::uint64_t>(locator.data() + 8),
+                                                       mugen::def::internal::ZIP64_EOCD_SIZE);
+    if (mugen::def::internal::load_le<std::uint32_t>(record.data()) != mugen::def::internal::ZIP64_EOCD_SIGNATURE) {
+      throw mugen::def::InvalidFormatError{"Zip64 end of central directory record is broken."};
+    }
+    entryCount = mugen::def::internal::load_le<std::uint64_t>(record.data() + 32);
+    directorySize = mugen::def::internal::load_le<std::uint64_t>(record.data() + 40);
+    directoryOffset = mugen::def::internal::load_le<std::uint64_t>(record.data() + 48);
+  }
+
+  auto directory = mugen::def::internal::read_zip_bytes(file, directoryOffset, directorySize);
+  entries_.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(entryCount, directory.size() / mugen::def::internal::ZIP_CENTRAL_HEADER_SIZE)));
+
+  std::string_view rest{directory};
+  for (std::uint64_t i = 0; i < entryCount; ++i) {
+    if (rest.size() < mugen::def::internal::ZIP_CENTRAL_HEADER_SIZE ||
+        mugen::def::internal::load_le<std::uint32_t>(rest.data()) != mugen::def::internal::ZIP_CENTRAL_HEADER_SIGNATURE) {
+      throw mugen::def::InvalidFormatError{"Zip central directory is broken."};
+    }
+
+    std::size_t nameLength = mugen::def::internal::load_le<std::uint16_t>(rest.data() + 28);
+    std::size_t extraLength = mugen::def::internal::load_le<std::uint16_t>(rest.data() + 30);
+    std::size_t commentLength = mugen::def::internal::load_le<std::uint16_t>(rest.data() + 32);
+    auto recordSize = mugen::def::internal::ZIP_CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength;
+    if (rest.size() < recordSize) {
+      throw mugen::def::InvalidFormatError{"Zip central directory is broken."};
+    }
+
+    mugen::def::ZipEntry entry{
+        .name = std::string{rest.substr(mugen::def::internal::ZIP_CENTRAL_HEADER_SIZE, nameLength)},
+        .method = mugen::def::internal::load_le<std::uint16_t>(rest.data() + 10),
+        .flags = mugen::def::internal::load_le<std::uint16_t>(rest.data() + 8),
+        .crc32 = mugen::def::internal::load_le<std::uint32_t>(rest.data() + 16),
+        .compressedSize = mugen::def::internal::load_le<std::uint32_t>(rest.data() + 20),
+        .uncompressedSize = mugen::def::internal::load_le<std::uint32_t>(rest.data() + 24),
+        .localHeaderOffset = mugen::def::internal::load_le<std::uint32_t>(rest.data() + 42),
+    };
+    mugen::def::internal::apply_zip64_extra(entry, rest.substr(mugen::def::internal::ZIP_CENTRAL_HEADER_SIZE + nameLength, extraLength));
+    rest.remove_prefix(recordSize);
+
+    // ディレクトリは保持しない
+    auto generic = mugen::def::internal::zip_generic_name(entry);
+    if (generic.empty() || generic.back() == '/') {
+      continue;
+    }
+
+    lookup_.emplace(mugen::def::internal::join_generic_path({}, generic), entries_.size());
+    entries_.push_back(std::move(entry));
+  }
+}
+
+MDEFPARSER_INLINE mugen::def::ZipArchive::ZipArchive(ZipArchive&&) noexcept = default;
+MDEFPARSER_INLINE mugen::def::ZipArchive& mugen::def::ZipArchive::operator=(ZipArchive&&) noexcept = default;
+MDEFPARSER_INLINE mugen::def::ZipArchive::~ZipArchive() = default;
+
+MDEFPARSER_INLINE const mugen::def::ZipEntry* mugen::def::ZipArchive::find(std::string_view name) const {
+  auto it = lookup_.find(mugen::def::internal::join_generic_path({}, mugen::def::internal::zip_generic_name(name)));
+  if (it == lookup_.end()) {
+    return nullptr;
+  }
+  return &entries_[it->second];
+}
+
+MDEFPARSER_INLINE std::vector<const mugen::def::ZipEntry*> mugen::def::ZipArchive::def_entries() const {
+  std::vector<const mugen::def::ZipEntry*> defs{};
+  for (const auto& entry : entries_) {
+    auto lowered = mugen::def::internal::to_lower_ascii(entry.name);
+    if (lowered.ends_with(".def")) {
+      defs.push_back(&entry);
+    }
+  }
+  return defs;
+}
+
+MDEFPARSER_INLINE std::string mugen::def::ZipArchive::read(const mugen::def::ZipEntry& entry, std::uint64_t maxSize) const {
+  if (entry.flags & 0x0001) {
+    throw mugen::def::InvalidFormatError{"Encrypted zip entries are not supported."};
+  }
+  if (entry.method != 0 && entry.method != 8) {
+    throw mugen::def::InvalidFormatError{"Unsupported zip compression method."};
+  }
+  if (entry.uncompressedSize > maxSize) {
+    throw mugen::def::LimitExceededError{"Zip entry size exceeds the limit."};
+  }
+
+  const auto& file = *file_;
+  auto header = mugen::def::internal::read_zip_bytes(file, entry.localHeaderOffset, mugen::def::internal::ZIP_LOCAL_HEADER_SIZE);
+  if (mugen::def::internal::load_le<std::uint32_t>(header.data()) != mugen::def::internal::ZIP_LOCAL_HEADER_SIGNATURE) {
+    throw mugen::def::InvalidFormatError{"Zip local file header is broken."};
+  }
+  auto dataOffset = entry.localHeaderOffset + mugen::def::internal::ZIP_LOCAL_HEADER_SIZE +
+                    mugen::def::internal::load_le<std::uint16_t>(header.data() + 26) +
+                    mugen::def::internal::load_le<std::uint16_t>(header.data() + 28);
+  auto compressed = mugen::def::internal::read_zip_bytes(file, dataOffset, entry.compressedSize);
+
+  std::string data{};
+  if (entry.method == 0) {
+    if (compressed.size() != entry.uncompressedSize) {
+      throw mugen::def::InvalidFormatError{"Zip entry size mismatch."};
+    }
+    data = std::move(compressed);
+  } else {
+    data.resize(static_cast<std::size_t>(entry.uncompressedSize));
+
+    z_stream stream{};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+      throw mugen::def::InvalidFormatError{"Can't initialize zlib."};
+    }
+
+    // uInt に収まる単位で与える
+    std::size_t inputOffset = 0;
+    std::size_t outputOffset = 0;
+    int status = Z_OK;
+    do {
+      if (stream.avail_in == 0) {
+        auto chunk = std::min<std::size_t>(compressed.size() - inputOffset, 0x40000000);
+        stream.next_in = reinterpret_cast<Bytef*>(compressed.data() + inputOffset);
+        stream.avail_in = static_cast<uInt>(chunk);
+        inputOffset += chunk;
+      }
+      if (stream.avail_out == 0) {
+        auto chunk = std::min<std::size_t>(data.size() - outputOffset, 0x40000000);
+        stream.next_out = reinterpret_cast<Bytef*>(data.data() + outputOffset);
+        stream.avail_out = static_cast<uInt>(chunk);
+        outputOffset += chunk;
+      }
+      status = inflate(&stream, Z_NO_FLUSH);
+    } while (status == Z_OK);
+    auto inflated = outputOffset - stream.avail_out;
+    inflateEnd(&stream);
+
+    if (status != Z_STREAM_END || inflated != data.size()) {
+      throw mugen::def::InvalidFormatError{"Can't inflate the zip entry."};
+    }
+  }
+
+  auto crc = ::crc32(0L, Z_NULL, 0);
+  for (std::size_t offset = 0; offset < data.size(); offset += 0x40000000) {
+    auto length = static_cast<uInt>(std::min<std::size_t>(data.size() - offset, 0x40000000));
+    crc = ::crc32(crc, reinterpret_cast<const Bytef*>(data.data() + offset), length);
+  }
+  if (crc != entry.crc32) {
+    throw mugen::def::InvalidFormatError{"Zip entry CRC mismatch."};
+  }
+
+  return data;
+}
+
+MDEFPARSER_INLINE mugen::def::MugenDefWin mugen::def::ZipArchive::parse_def(const mugen::def::ZipEntry& entry,
+                                                                            mugen::def::DefParserWin& parser) const {
+  return parser.parse_buffer(read(entry, parser.limits().maxFileSize));
+}
+
+MDEFPARSER_INLINE const mugen::def::ZipEntry* mugen::def::ZipArchive::find_referenced(const mugen::def::ZipEntry& defEntry,
+                                                                                      const std::filesystem::path& value) const {
+  // def の値は std::filesystem::path に変換する前のバイト列 (string()) のままエントリ名と比較する
+  auto base = mugen::def::internal::zip_generic_name(defEntry);
+  auto slash = base.rfind('/');
+  base = slash == std::string::npos ? std::string{} : base.substr(0, slash);
+
+  auto it = lookup_.find(mugen::def::internal::join_generic_path(base, mugen::def::internal::zip_generic_name(value.string())));
+  if (it == lookup_.end()) {
+    return nullptr;
+  }
+  return &entries_[it->second];
+}
+
+MDEFPARSER_INLINE std::vector<mugen::def::BatchResult<mugen::def::MugenDefWin>> mugen::def::ZipArchive::parse_defs(mugen::def::DefParserWin& parser,
+                                                                                                              unsigned jobs) const {
+  auto defs = def_entries();
+  std::vector<mugen::def::BatchResult<mugen::def::MugenDefWin>> results(defs.size());
+  mugen::def::internal::parallel_for(defs.size(), jobs, [&](std::size_t i) {
+    results[i] = mugen::def::internal::capture_result<mugen::def::MugenDefWin>([&]() { return parse_def(*defs[i], parser); });
+  });
+  return results;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file intern.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_INTERN_HPP__
+#define MDEFPARSER_INTERN_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/batch.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+using StringHandle = std::uint32_t;
+
+// 同じ文字列を 1 度だけ保持するプール
+// ハッシュ値ごとにストライプへ分け、ストライプ単位でロックするので複数スレッドから同時に intern() できる
+// 返したハンドルと view() が返す string_view はプールが破棄されるまで有効
+class StringPool {
+ public:
+  static constexpr StringHandle npos = 0xFFFFFFFF;
+
+  StringPool(const StringPool&) = delete;
+  StringPool& operator=(const StringPool&) = delete;
+
+  StringPool(StringPool&&) = delete;
+  StringPool& operator=(StringPool&&) = delete;
+
+  // stripeCount は 2 の冪 (1 ～ 256) に切り上げる
+  explicit StringPool(std::size_t stripeCount = 16);
+
+  StringHandle intern(std::string_view value);
+  std::optional<StringHandle> find(std::string_view value) const;
+  std::string_view view(StringHandle handle) const;
+
+  // 保持している文字列の数
+  std::size_t size() const;
+  // 文字列の格納に確保したバイト数
+  std::size_t memory_usage() const;
+
+ private:
+  struct Stripe {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::string_view, StringHandle> lookup;
+    std::vector<std::string_view> entries;
+    std::vector<std::unique_ptr<char[]>> chunks;
+    std::vector<std::unique_ptr<char[]>> large;
+    std::size_t chunkUsed = 0;
+    std::size_t chunkSize = 0;
+    std::size_t allocated = 0;
+  };
+
+  std::string_view store(Stripe& stripe, std::string_view value);
+
+  std::vector<std::unique_ptr<Stripe>> stripes_;
+  unsigned stripeBits_;
+};
+
+// MugenDefWin の各項目を StringPool のハンドルで持つ表現 (項目が無い場合は StringPool::npos)
+// バージョンと pal.defaults はリトルエンディアンの i32 列としてプールに格納する
+// followArcade で読み込んだ storyboard は保持しない
+struct InternedDefWin {
+  std::array<StringHandle, DefParseKeyCount> items;
+
+  bool has(DefParseKey key) const noexcept {
+    return items[static_cast<std::size_t>(key)] != StringPool::npos;
+  }
+};
+
+InternedDefWin intern(const MugenDefWin& def, StringPool& pool);
+MugenDefWin materialize(const InternedDefWin& def, const StringPool& pool);
+
+// パースしたものから順にプールへ格納するので、MugenDefWin を全件同時に保持しない
+std::vector<BatchResult<InternedDefWin>> parse_batch_interned(DefParserWin& parser,
+                                                              std::span<const std::filesystem::path> paths,
+                                                              StringPool& pool,
+                                                              unsigned jobs = 0);
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/intern.cpp"
+#endif
+
+#endif  // MDEFPARSER_INTERN_HPP__
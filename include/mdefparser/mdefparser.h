@@ -22,7 +22,11 @@
 #ifndef MDEFPARSER_H__
 #define MDEFPARSER_H__
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <string_view>
 
 namespace mugen {
 namespace def {
@@ -79,6 +83,26 @@ enum class DefParseKey {
 template <DefParseKey Key>
 struct DefItemType;
 
+struct StoryboardDef;
+
+class FileSource;
+
+// 悪意のある入力や壊れた入力で 1 ファイルのパースが長引かないようにするための上限
+// いずれかを超えた時点で LimitExceededError を投げる
+struct ParseLimits {
+  // ファイルサイズ
+  std::uint64_t maxFileSize = 16 * 1024 * 1024;
+  // 必須セクション ([Info], [Files]) が揃うまでに読み進めるバイト数
+  std::uint64_t maxScanBytes = 1024 * 1024;
+  // 1 行の長さ
+  std::size_t maxLineLength = 64 * 1024;
+  // セクションの数
+  std::size_t maxSections = 4096;
+  // 0 以外の場合は最初にこのバイト数だけを読み込み、必須項目が揃っていればそれ以上は読まない
+  // (それより後にある必須でない項目は読まれない)
+  std::size_t prefixBytes = 0;
+};
+
 template <MugenVersion Version>
 class DefParser {
  public:
@@ -89,11 +113,27 @@ class DefParser {
   DefParser& operator=(DefParser&&) = default;
 
   explicit DefParser() noexcept;
+  explicit DefParser(const ParseLimits& limits) noexcept;
+  // ファイルを source から読み込む (nullptr の場合はファイルシステムから直接読み込む)
+  explicit DefParser(std::shared_ptr<const FileSource> source, const ParseLimits& limits = ParseLimits{}) noexcept;
+
+  const ParseLimits& limits() const noexcept;
+  void set_limits(const ParseLimits& limits) noexcept;
 
+  const std::shared_ptr<const FileSource>& source() const noexcept;
+  void set_source(std::shared_ptr<const FileSource> source) noexcept;
+
+  // storyboard も読み込む parse() と並列にパースする parse_batch() は mdefparser/async.hpp にある
   MugenDef<Version> parse(const std::filesystem::path& path);
+  // メモリ上の def の内容をパースする (アーカイブから取り出したものなど)
+  MugenDef<Version> parse_buffer(std::string_view content);
 
   template <DefParseKey Key>
   typename DefItemType<Key>::type parse_item(const std::filesystem::path& path);
+
+ private:
+  ParseLimits limits_;
+  std::shared_ptr<const FileSource> source_;
 };
 
 using DefParserWin = DefParser<MugenVersion::Win>;
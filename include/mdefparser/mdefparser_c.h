@@ -0,0 +1,161 @@
+/**
+ * @file mdefparser_c.h
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_C_H__
+#define MDEFPARSER_C_H__
+
+/* C や FFI (Python, C#, Rust など) から使うための C API */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 共有ライブラリとしてビルドした場合に関数を公開する
+ * (Windows ではライブラリのビルド時に MDEFPARSER_C_EXPORTS、DLL の利用時に MDEFPARSER_C_SHARED を定義する) */
+#if defined(_WIN32)
+#if defined(MDEFPARSER_C_EXPORTS)
+#define MDEF_API __declspec(dllexport)
+#elif defined(MDEFPARSER_C_SHARED)
+#define MDEF_API __declspec(dllimport)
+#else
+#define MDEF_API
+#endif
+#elif defined(__GNUC__)
+#define MDEF_API __attribute__((visibility("default")))
+#else
+#define MDEF_API
+#endif
+
+/* 構造体の配置や関数を互換性のない形で変更した場合に増やす */
+#define MDEF_ABI_VERSION 1
+
+/* mugen::def::DefParseKey と同じ順序 */
+typedef enum mdef_key {
+  MDEF_KEY_NAME,
+  MDEF_KEY_DISPLAYNAME,
+  MDEF_KEY_VERSIONDATE,
+  MDEF_KEY_MUGENVERSION,
+  MDEF_KEY_AUTHOR,
+  MDEF_KEY_PAL_DEFAULTS,
+  MDEF_KEY_CMD,
+  MDEF_KEY_CNS,
+  MDEF_KEY_ST,
+  MDEF_KEY_STCOMMON,
+  MDEF_KEY_ST0,
+  MDEF_KEY_ST1,
+  MDEF_KEY_ST2,
+  MDEF_KEY_ST3,
+  MDEF_KEY_ST4,
+  MDEF_KEY_ST5,
+  MDEF_KEY_ST6,
+  MDEF_KEY_ST7,
+  MDEF_KEY_ST8,
+  MDEF_KEY_ST9,
+  MDEF_KEY_AI,
+  MDEF_KEY_SPRITE,
+  MDEF_KEY_ANIM,
+  MDEF_KEY_SOUND,
+  MDEF_KEY_PAL1,
+  MDEF_KEY_PAL2,
+  MDEF_KEY_PAL3,
+  MDEF_KEY_PAL4,
+  MDEF_KEY_PAL5,
+  MDEF_KEY_PAL6,
+  MDEF_KEY_PAL7,
+  MDEF_KEY_PAL8,
+  MDEF_KEY_PAL9,
+  MDEF_KEY_PAL10,
+  MDEF_KEY_PAL11,
+  MDEF_KEY_PAL12,
+  MDEF_KEY_INTRO,
+  MDEF_KEY_ENDING,
+  MDEF_KEY_COUNT
+} mdef_key;
+
+typedef enum mdef_status {
+  MDEF_OK,
+  MDEF_ERROR_FILE_IO,
+  MDEF_ERROR_DEQUOTATION,
+  MDEF_ERROR_MISSING_KEY,
+  MDEF_ERROR_INVALID_FORMAT,
+  MDEF_ERROR_LIMIT_EXCEEDED,
+  /* strings に結果の文字列が入りきらなかった */
+  MDEF_ERROR_INSUFFICIENT_BUFFER,
+  MDEF_ERROR_UNKNOWN
+} mdef_status;
+
+/* strings 内の文字列 (末尾に NUL を付ける、length は NUL を含まない) */
+typedef struct mdef_string {
+  uint64_t offset;
+  uint32_t length;
+  /* 0 の場合は項目がない */
+  uint32_t present;
+} mdef_string;
+
+typedef struct mdef_version {
+  int32_t month;
+  int32_t day;
+  int32_t year;
+  int32_t present;
+} mdef_version;
+
+typedef struct mdef_result {
+  /* mdef_status */
+  int32_t status;
+  /* palDefaults の要素数 (pal.defaults がない場合は 0、5 個目以降は切り捨てる) */
+  int32_t palDefaultsCount;
+  int32_t palDefaults[4];
+  mdef_version versionDate;
+  mdef_version mugenVersion;
+  /* mdef_key で引く
+   * name, displayname, author はファイル内のバイト列のまま、ファイル名は UTF-8
+   * versiondate, mugenversion, pal.defaults は上のメンバーに入り、ここは present = 0 となる */
+  mdef_string items[MDEF_KEY_COUNT];
+} mdef_result;
+
+MDEF_API uint32_t mdef_abi_version(void);
+
+MDEF_API const char* mdef_status_message(int32_t status);
+
+/* paths (UTF-8) の count 個のファイルを jobs 本のスレッドで並列にパースし、
+ * results[i] に paths[i] の結果を書き込む (jobs == 0 の場合はハードウェアスレッド数)
+ * 文字列は呼び出し元が確保した strings に詰めて書き込む (結果の並び順とは一致しない)
+ * 戻り値はパースに成功したすべての結果の文字列に必要なバイト数
+ * stringsCapacity がそれより小さい場合、入りきらなかった結果は MDEF_ERROR_INSUFFICIENT_BUFFER となる */
+MDEF_API size_t mdef_parse_batch(const char* const* paths,
+                                 size_t count,
+                                 mdef_result* results,
+                                 char* strings,
+                                 size_t stringsCapacity,
+                                 unsigned jobs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(__cplusplus) && defined(MDEFPARSER_HEADER_ONLY)
+#include "mdefparser/impl/mdefparser_c.cpp"
+#endif
+
+#endif  // MDEFPARSER_C_H__
@@ -24,10 +24,15 @@
 
 #include "mdefparser/mdefparser.h"
 
+#include <bitset>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace mugen {
@@ -41,6 +46,12 @@ struct MugenDefVersion {
   std::int32_t year;
 };
 
+struct StoryboardDef {
+  std::filesystem::path sprite;
+  std::optional<std::filesystem::path> sound;
+  std::size_t sceneCount;
+};
+
 template <>
 struct mugen::def::DefItemType<mugen::def::DefParseKey::Name> {
   using type = std::string;
@@ -336,9 +347,137 @@ struct MugenDef<MugenVersion::Win> {
   struct Arcade {
     std::optional<DefItemType<DefParseKey::Intro>::type> intro;
     std::optional<DefItemType<DefParseKey::Ending>::type> ending;
+
+    // ParseOptions::followArcade を指定した場合のみ設定される
+    std::optional<StoryboardDef> introStoryboard;
+    std::optional<StoryboardDef> endingStoryboard;
   } arcade;
 };
 
+inline constexpr std::size_t DefParseKeyCount = static_cast<std::size_t>(DefParseKey::Ending) + 1;
+
+// DefParseKey に対応するメンバーへの参照を返す
+// 必須項目は DefItemType<Key>::type&、それ以外は std::optional<DefItemType<Key>::type>& となる
+template <DefParseKey Key, class Def>
+constexpr auto& get_item(Def& def) noexcept {
+  static_assert(std::is_same_v<std::remove_const_t<Def>, MugenDef<MugenVersion::Win>>);
+
+  if constexpr (Key == DefParseKey::Name) {
+    return def.info.name;
+  } else if constexpr (Key == DefParseKey::DsiplayName) {
+    return def.info.displayName;
+  } else if constexpr (Key == DefParseKey::VersionDate) {
+    return def.info.versionDate;
+  } else if constexpr (Key == DefParseKey::MugenVersion) {
+    return def.info.mugenVersion;
+  } else if constexpr (Key == DefParseKey::Author) {
+    return def.info.author;
+  } else if constexpr (Key == DefParseKey::PalDefaults) {
+    return def.info.palDefaults;
+  } else if constexpr (Key == DefParseKey::Cmd) {
+    return def.files.cmd;
+  } else if constexpr (Key == DefParseKey::Cns) {
+    return def.files.cns;
+  } else if constexpr (Key == DefParseKey::St) {
+    return def.files.st;
+  } else if constexpr (Key == DefParseKey::StCommon) {
+    return def.files.stcommon;
+  } else if constexpr (Key == DefParseKey::St0) {
+    return def.files.st0;
+  } else if constexpr (Key == DefParseKey::St1) {
+    return def.files.st1;
+  } else if constexpr (Key == DefParseKey::St2) {
+    return def.files.st2;
+  } else if constexpr (Key == DefParseKey::St3) {
+    return def.files.st3;
+  } else if constexpr (Key == DefParseKey::St4) {
+    return def.files.st4;
+  } else if constexpr (Key == DefParseKey::St5) {
+    return def.files.st5;
+  } else if constexpr (Key == DefParseKey::St6) {
+    return def.files.st6;
+  } else if constexpr (Key == DefParseKey::St7) {
+    return def.files.st7;
+  } else if constexpr (Key == DefParseKey::St8) {
+    return def.files.st8;
+  } else if constexpr (Key == DefParseKey::St9) {
+    return def.files.st9;
+  } else if constexpr (Key == DefParseKey::Ai) {
+    return def.files.ai;
+  } else if constexpr (Key == DefParseKey::Sprite) {
+    return def.files.sprite;
+  } else if constexpr (Key == DefParseKey::Anim) {
+    return def.files.anim;
+  } else if constexpr (Key == DefParseKey::Sound) {
+    return def.files.sound;
+  } else if constexpr (Key == DefParseKey::Pal1) {
+    return def.files.pal1;
+  } else if constexpr (Key == DefParseKey::Pal2) {
+    return def.files.pal2;
+  } else if constexpr (Key == DefParseKey::Pal3) {
+    return def.files.pal3;
+  } else if constexpr (Key == DefParseKey::Pal4) {
+    return def.files.pal4;
+  } else if constexpr (Key == DefParseKey::Pal5) {
+    return def.files.pal5;
+  } else if constexpr (Key == DefParseKey::Pal6) {
+    return def.files.pal6;
+  } else if constexpr (Key == DefParseKey::Pal7) {
+    return def.files.pal7;
+  } else if constexpr (Key == DefParseKey::Pal8) {
+    return def.files.pal8;
+  } else if constexpr (Key == DefParseKey::Pal9) {
+    return def.files.pal9;
+  } else if constexpr (Key == DefParseKey::Pal10) {
+    return def.files.pal10;
+  } else if constexpr (Key == DefParseKey::Pal11) {
+    return def.files.pal11;
+  } else if constexpr (Key == DefParseKey::Pal12) {
+    return def.files.pal12;
+  } else if constexpr (Key == DefParseKey::Intro) {
+    return def.arcade.intro;
+  } else {
+    static_assert(Key == DefParseKey::Ending);
+    return def.arcade.ending;
+  }
+}
+
+template <DefParseKey Key>
+inline constexpr bool is_required_item = !std::is_same_v<std::remove_cvref_t<decltype(get_item<Key>(std::declval<MugenDef<MugenVersion::Win>&>()))>,
+                                                         std::optional<typename DefItemType<Key>::type>>;
+
+// すべての DefParseKey について function(std::integral_constant<DefParseKey, Key>{}) を順に呼び出す
+template <class Function>
+constexpr void for_each_key(Function&& function) {
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    (function(std::integral_constant<DefParseKey, static_cast<DefParseKey>(I)>{}), ...);
+  }(std::make_index_sequence<DefParseKeyCount>{});
+}
+
+// 出力する項目の選択などに使う DefParseKey の集合 (bit N が N 番目の DefParseKey)
+using DefKeySet = std::bitset<DefParseKeyCount>;
+
+constexpr std::string_view key_name(DefParseKey key) noexcept {
+  std::string_view name{};
+  for_each_key([&](auto item) {
+    if (item.value == key) {
+      name = DefItemType<item.value>::key;
+    }
+  });
+  return name;
+}
+
+// DefItemType<Key>::key ("name", "pal.defaults", "intro.storyboard" など) から DefParseKey を求める
+constexpr std::optional<DefParseKey> find_key(std::string_view name) noexcept {
+  std::optional<DefParseKey> key{};
+  for_each_key([&](auto item) {
+    if (!key && DefItemType<item.value>::key == name) {
+      key = item.value;
+    }
+  });
+  return key;
+}
+
 };  // namespace def
 };  // namespace mugen
 
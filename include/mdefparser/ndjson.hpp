@@ -0,0 +1,78 @@
+/**
+ * @file ndjson.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_NDJSON_HPP__
+#define MDEFPARSER_NDJSON_HPP__
+
+#include "mdefparser/mdefparser.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace mugen {
+namespace def {
+
+// 1 行 1 オブジェクトの JSON (NDJSON) を出力する
+//
+//   {"path":"...","name":"...","versiondate":[12,27,2007],"pal.defaults":[6,3],"cmd":"...",...}
+//   {"path":"...","error":"..."}
+//
+// キーは DefItemType<Key>::key で、存在しない任意項目と keys に含まれない項目は出力しない
+// UTF-8 として不正な文字列 (CP932 など) は各バイトを \u00XX として出力し、直後に "<key>Encoding":"bytes" を付ける
+// (例: "name":"\u0083L\u0083\u0093\u0083O","nameEncoding":"bytes")
+// 読み込み側はこの印がある値のみ、各文字 (U+0000 ~ U+00FF) を 1 バイトに戻せば元のバイト列を復元できる
+class NdjsonWriter {
+ public:
+  NdjsonWriter(const NdjsonWriter&) = delete;
+  NdjsonWriter& operator=(const NdjsonWriter&) = delete;
+
+  explicit NdjsonWriter(std::ostream& out, const DefKeySet& keys = DefKeySet{}.set()) noexcept;
+
+  void write(const std::filesystem::path& path, const MugenDefWin& def);
+  void write_error(const std::filesystem::path& path, std::string_view message);
+
+ private:
+  std::ostream& out_;
+  DefKeySet keys_;
+  std::string buffer_;
+};
+
+struct NdjsonExportSummary {
+  std::size_t succeeded;
+  std::size_t failed;
+};
+
+// paths を並列にパースし、パースが終わったものから順に 1 行ずつ書き出す
+// 結果を溜め込まないため、メモリ使用量はファイル数によらない
+NdjsonExportSummary export_ndjson(std::span<const std::filesystem::path> paths, std::ostream& out, unsigned jobs = 0);
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/ndjson.cpp"
+#endif
+
+#endif  // MDEFPARSER_NDJSON_HPP__
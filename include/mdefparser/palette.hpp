@@ -0,0 +1,87 @@
+/**
+ * @file palette.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_PALETTE_HPP__
+#define MDEFPARSER_PALETTE_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/catalog.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+inline constexpr std::size_t ACT_FILE_SIZE = 256 * 3;
+inline constexpr std::size_t RGBA_PALETTE_SIZE = 256 * 4;
+inline constexpr std::size_t PALETTE_SLOT_COUNT = 12;
+
+// ACT (256 色の RGB を色番号の逆順に並べたもの) を色番号順の RGBA8 に変換する
+// 色番号 0 は透明色として alpha = 0 とする
+void act_to_rgba(std::span<const std::uint8_t, ACT_FILE_SIZE> act, std::span<std::uint8_t, RGBA_PALETTE_SIZE> rgba) noexcept;
+
+struct PaletteSet {
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  // 読み込んだパレットを RGBA_PALETTE_SIZE バイトずつ詰めたもの (そのままテクスチャとして転送できる)
+  std::vector<std::uint8_t> rgba;
+  // rgba 内の各パレットのファイル (同じファイルは 1 度だけ読み込む)
+  std::vector<std::filesystem::path> files;
+  // 読み込めなかったパレットの例外 (rgba 内の該当部分は 0 で埋める)
+  std::vector<std::exception_ptr> errors;
+  // slots[entries 内の位置 * PALETTE_SLOT_COUNT + N - 1] が palN の rgba 内のパレット番号 (palN が無い場合は npos)
+  std::vector<std::size_t> slots;
+
+  std::span<const std::uint8_t, RGBA_PALETTE_SIZE> palette(std::size_t index) const noexcept {
+    return std::span<const std::uint8_t, RGBA_PALETTE_SIZE>{rgba.data() + index * RGBA_PALETTE_SIZE, RGBA_PALETTE_SIZE};
+  }
+};
+
+class ActReader {
+ public:
+  ActReader(const ActReader&) = delete;
+  ActReader& operator=(const ActReader&) = delete;
+
+  ActReader(ActReader&&) = default;
+  ActReader& operator=(ActReader&&) = default;
+
+  explicit ActReader() noexcept;
+
+  std::vector<std::uint8_t> read(const std::filesystem::path& path);
+
+  // entries の pal1 ~ pal12 をまとめて jobs 本のスレッドで並列に読み込む (jobs == 0 の場合はハードウェアスレッド数)
+  PaletteSet read_palettes(std::span<const CatalogEntry> entries, unsigned jobs = 0);
+};
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/palette.cpp"
+#endif
+
+#endif  // MDEFPARSER_PALETTE_HPP__
@@ -0,0 +1,97 @@
+/**
+ * @file patch.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_PATCH_HPP__
+#define MDEFPARSER_PATCH_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/batch.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+// def の値のみを書き換える
+// 書き換えた値以外 (コメント、項目の順序、改行文字など) はバイト単位でそのまま残す
+// 項目の探し方は DefParser と同じで、各セクションの最初のもののみを対象にする
+class DefPatcher {
+ public:
+  DefPatcher(const DefPatcher&) = delete;
+  DefPatcher& operator=(const DefPatcher&) = delete;
+
+  DefPatcher(DefPatcher&&) = default;
+  DefPatcher& operator=(DefPatcher&&) = default;
+
+  explicit DefPatcher() noexcept;
+
+  void load(const std::filesystem::path& path);
+  void load_buffer(std::string content);
+
+  // ファイルに書かれたままの値 (コメントと前後の空白を除く)
+  std::optional<std::string_view> raw_value(DefParseKey key) const;
+
+  // value をそのまま書き込む
+  // 項目がなければセクションの最後の項目の後に、セクションもなければ末尾に追加する
+  // 改行と ';' を含む値は InvalidFormatError
+  void set_raw_value(DefParseKey key, std::string_view value);
+
+  // name, displayname, author は引用符で囲んで書き込む
+  void set_value(DefParseKey key, std::string_view value);
+
+  bool modified() const noexcept {
+    return modified_;
+  }
+
+  const std::string& content() const noexcept {
+    return content_;
+  }
+
+  // 同じフォルダの一時ファイルに書き込んでから置き換える
+  void save(const std::filesystem::path& path) const;
+
+ private:
+  std::string content_;
+  bool modified_;
+};
+
+// paths の各ファイルを edit(path, patcher) で書き換え、変更があったもののみを保存する
+// 結果は保存したかどうか
+// jobs == 0 の場合はハードウェアスレッド数で並列に処理する
+std::vector<BatchResult<bool>> patch_batch(std::span<const std::filesystem::path> paths,
+                                           const std::function<void(const std::filesystem::path&, DefPatcher&)>& edit,
+                                           unsigned jobs = 0);
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/patch.cpp"
+#endif
+
+#endif  // MDEFPARSER_PATCH_HPP__
@@ -0,0 +1,144 @@
+/**
+ * @file scan.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_SCAN_HPP__
+#define MDEFPARSER_SCAN_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/batch.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+// root 以下の .def ファイル (拡張子の大文字小文字は区別しない) を再帰的に集める
+// root がファイルの場合は root のみを返す
+// 読み込めないディレクトリは読み飛ばす
+std::vector<std::filesystem::path> find_def_files(const std::filesystem::path& root);
+
+// paths を読み込む順序 (paths 内の位置) を返す
+// 回転ディスクでのシークを減らすため、デバイス、親フォルダの inode、ファイルの inode の順に並べる
+// 情報を取得できないファイルは末尾に回す (Windows では親フォルダごとにまとめるのみ)
+std::vector<std::size_t> locality_order(std::span<const std::filesystem::path> paths);
+
+// locality_order() の順にパースし、パースが終わったものから順に callback(paths 内の位置, 結果) を呼び出す
+// これから読む readahead 件のファイルには先読みを要求する (posix_fadvise が使える環境のみ)
+// callback は複数のスレッドから同時に呼び出される
+void parse_in_locality_order(std::span<const std::filesystem::path> paths,
+                             DefParserWin& parser,
+                             const std::function<void(std::size_t, BatchResult<MugenDefWin>&&)>& callback,
+                             unsigned jobs = 0,
+                             std::size_t readahead = 64);
+
+struct ScanItem {
+  std::filesystem::path path;
+  BatchResult<MugenDefWin> result;
+};
+
+// scan_stream() の結果を受け取る入力範囲
+// パースが終わったものから順に取り出せる (順序は不定)
+// 途中で破棄した場合は残りのパースを打ち切る
+class ScanStream {
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = ScanItem;
+
+    iterator() noexcept : stream_{nullptr} {}
+    explicit iterator(ScanStream* stream) noexcept : stream_{stream} {}
+
+    ScanItem& operator*() const noexcept {
+      return *stream_->current_;
+    }
+    ScanItem* operator->() const noexcept {
+      return &*stream_->current_;
+    }
+
+    iterator& operator++() {
+      stream_->next();
+      return *this;
+    }
+    void operator++(int) {
+      ++*this;
+    }
+
+    friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept {
+      return it.at_end();
+    }
+
+   private:
+    bool at_end() const noexcept {
+      return !stream_ || !stream_->current_;
+    }
+
+    ScanStream* stream_;
+  };
+
+  ScanStream(const ScanStream&) = delete;
+  ScanStream& operator=(const ScanStream&) = delete;
+
+  ScanStream(ScanStream&&) noexcept;
+  ScanStream& operator=(ScanStream&&) noexcept;
+
+  ~ScanStream();
+
+  // 最初の結果が届くまで待つ
+  iterator begin();
+  std::default_sentinel_t end() const noexcept {
+    return std::default_sentinel;
+  }
+
+ private:
+  struct State;
+
+  explicit ScanStream(std::unique_ptr<State> state) noexcept;
+  void next();
+
+  friend ScanStream scan_stream(const std::filesystem::path& root, DefParserWin&& parser, unsigned jobs, std::size_t capacity);
+
+  std::unique_ptr<State> state_;
+  std::optional<ScanItem> current_;
+};
+
+// root 以下の .def ファイル (find_def_files() と同じ条件) を探しながら並列にパースし、結果を順に返す
+// ファイルを探すスレッドとパースするスレッドは結果を容量 capacity のキューに積み、消費が追いつかない間は待つ
+// root が存在しない場合は FileIOError を投げる
+ScanStream scan_stream(const std::filesystem::path& root, unsigned jobs = 0, std::size_t capacity = 256);
+ScanStream scan_stream(const std::filesystem::path& root, DefParserWin&& parser, unsigned jobs = 0, std::size_t capacity = 256);
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/scan.cpp"
+#endif
+
+#endif  // MDEFPARSER_SCAN_HPP__
@@ -0,0 +1,82 @@
+/**
+ * @file select.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_SELECT_HPP__
+#define MDEFPARSER_SELECT_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/batch.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+struct SelectCharacter {
+  // select.def に書かれたままの名前 ("kfm", "kfm/kfm720.def", "randomselect" など)
+  std::string name;
+  bool randomSelect;
+  // 2 番目の項目 ("random" の場合もそのまま格納する)
+  std::optional<std::filesystem::path> stage;
+  // music=..., includestage=..., order=... などの追加項目 (キーは小文字)
+  std::vector<std::pair<std::string, std::string>> options;
+  // 解決したキャラクターの def ファイル (randomselect の場合は std::nullopt)
+  std::optional<std::filesystem::path> defPath;
+};
+
+struct SelectDef {
+  // [Characters] の記述順
+  std::vector<SelectCharacter> characters;
+  std::vector<std::filesystem::path> extraStages;
+};
+
+class SelectParser {
+ public:
+  SelectParser(const SelectParser&) = delete;
+  SelectParser& operator=(const SelectParser&) = delete;
+
+  SelectParser(SelectParser&&) = default;
+  SelectParser& operator=(SelectParser&&) = default;
+
+  explicit SelectParser() noexcept;
+
+  // MUGEN のフォルダは select.def のあるフォルダ (data) の親とみなす
+  SelectDef parse(const std::filesystem::path& path);
+  // キャラクターは mugenRoot/chars/<name>/<name>.def または mugenRoot/chars/<name> (.def で終わる場合) に解決する
+  SelectDef parse(const std::filesystem::path& path, const std::filesystem::path& mugenRoot);
+};
+
+// 各キャラクターの def を並列にパースし、characters と同じ順に結果を返す
+// randomselect の位置は value, error ともに空となる
+std::vector<BatchResult<MugenDefWin>> load_roster(const SelectDef& select, DefParserWin& parser, unsigned jobs = 0);
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/select.cpp"
+#endif
+
+#endif  // MDEFPARSER_SELECT_HPP__
@@ -0,0 +1,62 @@
+/**
+ * @file serialize.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_SERIALIZE_HPP__
+#define MDEFPARSER_SERIALIZE_HPP__
+
+#include "mdefparser/mdefparser.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace mugen {
+namespace def {
+
+// バイナリ形式 (リトルエンディアン)
+//
+//   "MDEF" | version:u8 | reserved:u8[3] | size:u32 | presence:u64 | 各項目
+//
+// presence の bit N は DefParseKey の N 番目の項目、
+// bit DefParseKeyCount / DefParseKeyCount + 1 は intro / ending の storyboard の有無を表す
+// 各項目は存在するもののみ DefParseKey の順に並び、タグは持たない
+//   文字列・パス: length:u32 + UTF-8 のバイト列
+//   バージョン: month:i32 | day:i32 | year:i32
+//   pal.defaults: count:u8 + i32 * count
+//   storyboard: sprite | hasSound:u8 | (sound) | sceneCount:u32
+inline constexpr std::uint8_t SerializeFormatVersion = 1;
+
+std::size_t serialized_size(const MugenDefWin& def);
+
+// 書き込んだバイト数を返す
+std::size_t serialize(const MugenDefWin& def, std::span<std::byte> out);
+
+// consumed が指定された場合は読み込んだバイト数を格納する
+MugenDefWin deserialize(std::span<const std::byte> in, std::size_t* consumed = nullptr);
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/serialize.cpp"
+#endif
+
+#endif  // MDEFPARSER_SERIALIZE_HPP__
@@ -0,0 +1,78 @@
+/**
+ * @file sff.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_SFF_HPP__
+#define MDEFPARSER_SFF_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/batch.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+struct SffSprite {
+  std::uint16_t group;
+  std::uint16_t index;
+  // 画像データのファイル先頭からのオフセットとサイズ (リンクされたスプライトはリンク先の値)
+  std::uint32_t offset;
+  std::uint32_t length;
+};
+
+struct SffIndex {
+  std::uint8_t version;
+  std::uint32_t spriteCount;
+  // (group, index) の昇順、重複は先に現れたもののみ
+  std::vector<SffSprite> sprites;
+
+  const SffSprite* find(std::uint16_t group, std::uint16_t index) const noexcept;
+  std::size_t count(std::uint16_t group) const noexcept;
+};
+
+class SffReader {
+ public:
+  SffReader(const SffReader&) = delete;
+  SffReader& operator=(const SffReader&) = delete;
+
+  SffReader(SffReader&&) = default;
+  SffReader& operator=(SffReader&&) = default;
+
+  explicit SffReader() noexcept;
+
+  // ヘッダーとスプライトのディレクトリのみを読み込み、画像データは読まない
+  SffIndex read_index(const std::filesystem::path& path);
+
+  // jobs == 0 の場合はハードウェアスレッド数で並列に読み込む
+  std::vector<BatchResult<SffIndex>> read_index_batch(std::span<const std::filesystem::path> paths, unsigned jobs = 0);
+};
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/sff.cpp"
+#endif
+
+#endif  // MDEFPARSER_SFF_HPP__
@@ -0,0 +1,107 @@
+/**
+ * @file source.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_SOURCE_HPP__
+#define MDEFPARSER_SOURCE_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/file_source.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+// pread (Windows では ReadFile) で読み込む
+class PreadFileSource : public FileSource {
+ public:
+  std::optional<FileStat> stat(const std::filesystem::path& path) const override;
+  std::unique_ptr<FileHandle> open(const std::filesystem::path& path) const override;
+};
+
+// ファイル全体をメモリにマップして読み込む
+class MmapFileSource : public FileSource {
+ public:
+  std::optional<FileStat> stat(const std::filesystem::path& path) const override;
+  std::unique_ptr<FileHandle> open(const std::filesystem::path& path) const override;
+};
+
+// 登録したメモリ上のデータをファイルとして扱う
+// パスは '/' 区切りに揃え、. と .. を取り除いてから比較する
+class MemoryFileSource : public FileSource {
+ public:
+  MemoryFileSource(const MemoryFileSource&) = delete;
+  MemoryFileSource& operator=(const MemoryFileSource&) = delete;
+
+  explicit MemoryFileSource() noexcept;
+
+  void add(const std::filesystem::path& path, std::string content);
+  // content はこのソースから開いたファイルがすべて破棄されるまで有効でなければならない
+  void add_view(const std::filesystem::path& path, std::string_view content);
+  void remove(const std::filesystem::path& path);
+
+  std::optional<FileStat> stat(const std::filesystem::path& path) const override;
+  std::unique_ptr<FileHandle> open(const std::filesystem::path& path) const override;
+
+ private:
+  struct Entry {
+    std::shared_ptr<const std::string> owner;
+    std::string_view data;
+    std::int64_t modified;
+  };
+
+  void insert(const std::filesystem::path& path, Entry&& entry);
+
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::int64_t revision_;
+};
+
+// 複数のソースを重ねたもの
+// 先頭のソースから順に探し、最初に見つかったファイルを使う
+class OverlayFileSource : public FileSource {
+ public:
+  explicit OverlayFileSource(std::vector<std::shared_ptr<const FileSource>> layers) noexcept;
+
+  std::optional<FileStat> stat(const std::filesystem::path& path) const override;
+  std::unique_ptr<FileHandle> open(const std::filesystem::path& path) const override;
+
+ private:
+  std::vector<std::shared_ptr<const FileSource>> layers_;
+};
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/source.cpp"
+#endif
+
+#endif  // MDEFPARSER_SOURCE_HPP__
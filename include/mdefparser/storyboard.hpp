@@ -0,0 +1,53 @@
+/**
+ * @file storyboard.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_STORYBOARD_HPP__
+#define MDEFPARSER_STORYBOARD_HPP__
+
+#include "mdefparser/mdefparser.h"
+
+#include <filesystem>
+
+namespace mugen {
+namespace def {
+
+// [Arcade] の intro.storyboard / ending.storyboard に指定される storyboard の def を読み込む
+class StoryboardParser {
+ public:
+  StoryboardParser(const StoryboardParser&) = delete;
+  StoryboardParser& operator=(const StoryboardParser&) = delete;
+
+  StoryboardParser(StoryboardParser&&) = default;
+  StoryboardParser& operator=(StoryboardParser&&) = default;
+
+  explicit StoryboardParser() noexcept;
+
+  StoryboardDef parse(const std::filesystem::path& path);
+};
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/storyboard.cpp"
+#endif
+
+#endif  // MDEFPARSER_STORYBOARD_HPP__
@@ -0,0 +1,107 @@
+/**
+ * @file zip.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_ZIP_HPP__
+#define MDEFPARSER_ZIP_HPP__
+
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/batch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mugen {
+namespace def {
+
+namespace internal {
+class ReadOnlyFile;
+};  // namespace internal
+
+struct ZipEntry {
+  // アーカイブ内の名前 ('/' 区切り、文字コードはアーカイブのまま)
+  std::string name;
+  std::uint16_t method;
+  std::uint16_t flags;
+  std::uint32_t crc32;
+  std::uint64_t compressedSize;
+  std::uint64_t uncompressedSize;
+  std::uint64_t localHeaderOffset;
+};
+
+// zip アーカイブを展開せずに読み込む (展開には zlib を使用する)
+// 構築時はセントラルディレクトリのみを読み込み、各エントリは read() で必要になった時にメモリ上に展開する
+// 読み込みは位置指定で行うので、複数のスレッドから同時に read() / parse_def() できる
+class ZipArchive {
+ public:
+  ZipArchive(const ZipArchive&) = delete;
+  ZipArchive& operator=(const ZipArchive&) = delete;
+
+  ZipArchive(ZipArchive&&) noexcept;
+  ZipArchive& operator=(ZipArchive&&) noexcept;
+
+  explicit ZipArchive(const std::filesystem::path& path);
+  ~ZipArchive();
+
+  std::span<const ZipEntry> entries() const noexcept {
+    return entries_;
+  }
+
+  // ASCII の大文字小文字と区切り文字 ('/', '\\') を区別せずに探す
+  // 名前はバイト列のまま比較する (UTF-8 フラグのない名前は CP932 とみなし、2 バイト文字の途中は書き換えない)
+  const ZipEntry* find(std::string_view name) const;
+
+  // 拡張子が .def のエントリ
+  std::vector<const ZipEntry*> def_entries() const;
+
+  // 展開後のサイズが maxSize を超える場合は LimitExceededError を投げる
+  std::string read(const ZipEntry& entry, std::uint64_t maxSize = std::numeric_limits<std::uint64_t>::max()) const;
+
+  MugenDefWin parse_def(const ZipEntry& entry, DefParserWin& parser) const;
+
+  // def の files.* などに書かれた値を def のあるフォルダからの相対パスとして探す
+  // 値は def に書かれたバイト列のままエントリ名と比較する
+  const ZipEntry* find_referenced(const ZipEntry& defEntry, const std::filesystem::path& value) const;
+
+  // def_entries() の順に結果を返す
+  std::vector<BatchResult<MugenDefWin>> parse_defs(DefParserWin& parser, unsigned jobs = 0) const;
+
+ private:
+  std::unique_ptr<internal::ReadOnlyFile> file_;
+  std::vector<ZipEntry> entries_;
+  std::unordered_map<std::string, std::size_t> lookup_;
+};
+
+};  // namespace def
+};  // namespace mugen
+
+#ifdef MDEFPARSER_HEADER_ONLY
+#include "mdefparser/impl/zip.cpp"
+#endif
+
+#endif  // MDEFPARSER_ZIP_HPP__
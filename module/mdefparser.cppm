@@ -0,0 +1,187 @@
+/**
+ * @file mdefparser.cppm
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+module;
+
+// ヘッダーはグローバルモジュールフラグメントで一度だけ解析し、公開する名前のみを再エクスポートする
+#include "mdefparser/air.hpp"
+#include "mdefparser/async.hpp"
+#include "mdefparser/batch.hpp"
+#include "mdefparser/cache.hpp"
+#include "mdefparser/catalog.hpp"
+#include "mdefparser/cmd.hpp"
+#include "mdefparser/cns.hpp"
+#include "mdefparser/columnar.hpp"
+#include "mdefparser/diff.hpp"
+#include "mdefparser/exception.hpp"
+#include "mdefparser/file_source.hpp"
+#include "mdefparser/fingerprint.hpp"
+#include "mdefparser/intern.hpp"
+#include "mdefparser/mdefparser.h"
+#include "mdefparser/mugendef.hpp"
+#include "mdefparser/ndjson.hpp"
+#include "mdefparser/palette.hpp"
+#include "mdefparser/patch.hpp"
+#include "mdefparser/scan.hpp"
+#include "mdefparser/select.hpp"
+#include "mdefparser/serialize.hpp"
+#include "mdefparser/sff.hpp"
+#include "mdefparser/source.hpp"
+#include "mdefparser/storyboard.hpp"
+
+#ifdef MDEFPARSER_HAS_ZIP
+#include "mdefparser/zip.hpp"
+#endif
+
+export module mdefparser;
+
+export namespace mugen {
+namespace def {
+
+// mdefparser.h, mugendef.hpp, async.hpp, storyboard.hpp
+using mugen::def::DefItemType;
+using mugen::def::DefKeySet;
+using mugen::def::DefParseKey;
+using mugen::def::DefParseKeyCount;
+using mugen::def::DefParser;
+using mugen::def::DefParserWin;
+using mugen::def::find_key;
+using mugen::def::for_each_key;
+using mugen::def::get_item;
+using mugen::def::is_required_item;
+using mugen::def::key_name;
+using mugen::def::MugenDef;
+using mugen::def::MugenDefVersion;
+using mugen::def::MugenDefWin;
+using mugen::def::MugenVersion;
+using mugen::def::parse;
+using mugen::def::parse_batch;
+using mugen::def::ParseLimits;
+using mugen::def::ParseOptions;
+using mugen::def::StoryboardDef;
+using mugen::def::StoryboardParser;
+
+// batch.hpp, exception.hpp
+using mugen::def::BatchResult;
+using mugen::def::DequotationError;
+using mugen::def::FileIOError;
+using mugen::def::InsufficientBufferError;
+using mugen::def::InvalidFormatError;
+using mugen::def::LimitExceededError;
+using mugen::def::MissingKeyError;
+
+// air.hpp, cmd.hpp, cns.hpp, sff.hpp, palette.hpp
+using mugen::def::ACT_FILE_SIZE;
+using mugen::def::act_to_rgba;
+using mugen::def::ActReader;
+using mugen::def::AirAction;
+using mugen::def::AirActionRange;
+using mugen::def::AirBox;
+using mugen::def::AirFrame;
+using mugen::def::AirIndex;
+using mugen::def::AirReader;
+using mugen::def::CmdCommand;
+using mugen::def::CmdIndex;
+using mugen::def::CmdRange;
+using mugen::def::CmdReader;
+using mugen::def::CmdStateController;
+using mugen::def::CnsConstant;
+using mugen::def::CnsConstants;
+using mugen::def::parse_cns_constants;
+using mugen::def::parse_cns_constants_batch;
+using mugen::def::PALETTE_SLOT_COUNT;
+using mugen::def::PaletteSet;
+using mugen::def::RGBA_PALETTE_SIZE;
+using mugen::def::SffIndex;
+using mugen::def::SffReader;
+using mugen::def::SffSprite;
+
+// serialize.hpp, ndjson.hpp
+using mugen::def::deserialize;
+using mugen::def::export_ndjson;
+using mugen::def::NdjsonExportSummary;
+using mugen::def::NdjsonWriter;
+using mugen::def::serialize;
+using mugen::def::serialized_size;
+using mugen::def::SerializeFormatVersion;
+
+// scan.hpp, select.hpp
+using mugen::def::find_def_files;
+using mugen::def::locality_order;
+using mugen::def::parse_in_locality_order;
+using mugen::def::scan_stream;
+using mugen::def::ScanItem;
+using mugen::def::ScanStream;
+using mugen::def::load_roster;
+using mugen::def::SelectCharacter;
+using mugen::def::SelectDef;
+using mugen::def::SelectParser;
+
+// intern.hpp, catalog.hpp, columnar.hpp
+using mugen::def::CatalogEntry;
+using mugen::def::CatalogField;
+using mugen::def::ColumnarCatalog;
+using mugen::def::ColumnType;
+using mugen::def::CatalogDiff;
+using mugen::def::DefCatalog;
+using mugen::def::diff_catalogs;
+using mugen::def::DiffKind;
+using mugen::def::intern;
+using mugen::def::InternedDefWin;
+using mugen::def::materialize;
+using mugen::def::PalDefaultsColumn;
+using mugen::def::parse_batch_interned;
+using mugen::def::PresenceBitmap;
+using mugen::def::StringColumn;
+using mugen::def::StringHandle;
+using mugen::def::StringPool;
+using mugen::def::VersionColumn;
+
+// fingerprint.hpp, cache.hpp
+using mugen::def::CacheStats;
+using mugen::def::CachingDefParser;
+using mugen::def::FileDigest;
+using mugen::def::group_duplicates;
+using mugen::def::PackageFingerprint;
+using mugen::def::PackageHasher;
+using mugen::def::xxh64;
+
+// patch.hpp
+using mugen::def::DefPatcher;
+using mugen::def::patch_batch;
+
+// file_source.hpp, source.hpp
+using mugen::def::FileHandle;
+using mugen::def::FileSource;
+using mugen::def::FileStat;
+using mugen::def::MemoryFileSource;
+using mugen::def::MmapFileSource;
+using mugen::def::OverlayFileSource;
+using mugen::def::PreadFileSource;
+
+#ifdef MDEFPARSER_HAS_ZIP
+// zip.hpp
+using mugen::def::ZipArchive;
+using mugen::def::ZipEntry;
+#endif
+
+};  // namespace def
+};  // namespace mugen
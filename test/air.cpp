@@ -0,0 +1,90 @@
+/**
+ * @file air.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/air.hpp>
+#include <mdefparser/mdefparser.h>
+
+using namespace std::string_view_literals;
+
+static constexpr std::string_view NOT_EXISTING_FILE = "assets/not-existing-file.air"sv;
+
+TEST(test_air, common_read_error) {
+  auto reader = mugen::def::AirReader{};
+  EXPECT_THROW(reader.read_index(NOT_EXISTING_FILE), mugen::def::FileIOError);
+}
+
+TEST(test_air, read_index) {
+  static constexpr std::string_view kfmair = "assets/good/kfm.air"sv;
+
+  auto reader = mugen::def::AirReader{};
+  ASSERT_NO_THROW(reader.read_index(kfmair));
+  auto index = reader.read_index(kfmair);
+
+  ASSERT_EQ(index.actions.size(), 3);
+  EXPECT_EQ(index.actions[0].number, 0);
+  EXPECT_EQ(index.actions[1].number, 5);
+  EXPECT_EQ(index.actions[2].number, 20);
+
+  EXPECT_EQ(index.actions[0].begin, std::string_view{"; Standing Animation\n"}.size());
+  EXPECT_LT(index.actions[0].begin, index.actions[0].end);
+  EXPECT_LE(index.actions[0].end, index.actions[2].begin);
+
+  EXPECT_TRUE(index.find(5));
+  EXPECT_FALSE(index.find(1));
+}
+
+TEST(test_air, read_action) {
+  static constexpr std::string_view kfmair = "assets/good/kfm.air"sv;
+
+  auto reader = mugen::def::AirReader{};
+  auto index = reader.read_index(kfmair);
+
+  auto stand = reader.read_action(kfmair, *index.find(0));
+  EXPECT_EQ(stand.number, 0);
+  ASSERT_EQ(stand.frames.size(), 3);
+  EXPECT_FALSE(stand.loopStart);
+  EXPECT_EQ(stand.frames[0].time, 10);
+  ASSERT_EQ(stand.frames[2].clsn2.size(), 2);
+  EXPECT_EQ(stand.frames[2].clsn2[1].left, 5);
+  EXPECT_EQ(stand.frames[2].clsn2[1].bottom, -93);
+
+  auto walk = reader.read_action(kfmair, *index.find(20));
+  ASSERT_EQ(walk.frames.size(), 3);
+  EXPECT_EQ(walk.loopStart, 1);
+  EXPECT_EQ(walk.frames[1].group, 20);
+  EXPECT_EQ(walk.frames[1].index, 1);
+  EXPECT_EQ(walk.frames[1].flip, "H");
+  EXPECT_TRUE(walk.frames[1].clsn1.empty());
+  ASSERT_EQ(walk.frames[2].clsn1.size(), 1);
+  EXPECT_EQ(walk.frames[2].clsn1[0].right, 58);
+  EXPECT_EQ(walk.frames[2].blend, "A");
+  EXPECT_EQ(walk.frames[2].clsn2.size(), 1);
+
+  auto single = reader.read_action(kfmair, *index.find(5));
+  ASSERT_EQ(single.frames.size(), 1);
+  EXPECT_EQ(single.frames[0].time, -1);
+
+  auto wrong = *index.find(5);
+  wrong.number = 6;
+  EXPECT_THROW(reader.read_action(kfmair, wrong), mugen::def::InvalidFormatError);
+}
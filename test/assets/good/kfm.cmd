@@ -0,0 +1,41 @@
+; The CMD file.
+
+[Remap]
+x = x
+y = y
+
+[Defaults]
+command.time = 15
+
+;-| Super Motions |--------------------------------------------------------
+[Command]
+name = "TripleKFPalm"
+command = ~D, DF, F, D, DF, F, x
+time = 20
+
+[Command]
+name = "TripleKFPalm"   ;Same name as above
+command = ~D, DF, F, D, DF, F, y
+time = 20
+
+;-| Special Motions |------------------------------------------------------
+[Command]
+name = "upper_x"
+command = ~F, D, DF, x
+
+[Command]
+command = ~F, D, DF, y
+
+[Statedef -1]
+
+;===========================================================================
+[State -1, Triple Kung Fu Palm]
+type = ChangeState
+value = 3000
+triggerall = command = "TripleKFPalm"
+trigger1 = statetype = S
+
+[State -1]
+type = ChangeState
+value = 1100
+trigger1 = command = "upper_x"
@@ -0,0 +1,59 @@
+/**
+ * @file c_api.c
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* mdefparser_c.h を C としてコンパイルできることを確かめる (test/c_api.cpp から呼び出す) */
+
+#include <mdefparser/mdefparser_c.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+int mdef_c_api_parse_name(const char* path, char* name, size_t size) {
+  const char* paths[1];
+  mdef_result result;
+  char* strings;
+  size_t required;
+  int status;
+
+  paths[0] = path;
+  required = mdef_parse_batch(paths, 1, &result, NULL, 0, 1);
+  if (result.status != MDEF_OK && result.status != MDEF_ERROR_INSUFFICIENT_BUFFER) {
+    return result.status;
+  }
+
+  strings = (char*)malloc(required);
+  if (!strings) {
+    return MDEF_ERROR_UNKNOWN;
+  }
+  mdef_parse_batch(paths, 1, &result, strings, required, 1);
+
+  status = result.status;
+  if (status == MDEF_OK) {
+    const mdef_string* item = &result.items[MDEF_KEY_NAME];
+    if (item->length + 1 > size) {
+      status = MDEF_ERROR_INSUFFICIENT_BUFFER;
+    } else {
+      memcpy(name, strings + item->offset, item->length + 1);
+    }
+  }
+  free(strings);
+  return status;
+}
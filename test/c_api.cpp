@@ -0,0 +1,86 @@
+/**
+ * @file c_api.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/mdefparser_c.h>
+
+#include <string_view>
+#include <vector>
+
+#ifndef MDEFPARSER_HEADER_ONLY
+// test/c_api.c
+extern "C" int mdef_c_api_parse_name(const char* path, char* name, size_t size);
+#endif
+
+static std::string_view c_item(const mdef_result& result, const std::vector<char>& strings, mdef_key key) {
+  const auto& item = result.items[key];
+  return std::string_view{strings.data() + item.offset, item.length};
+}
+
+TEST(test_c_api, parse_batch) {
+  const char* paths[] = {"assets/good/kfm.def", "assets/not_found.def"};
+  mdef_result results[2]{};
+  std::vector<char> strings(4096);
+
+  auto required = mdef_parse_batch(paths, 2, results, strings.data(), strings.size(), 2);
+  EXPECT_GT(required, 0u);
+  EXPECT_LE(required, strings.size());
+
+  auto kfm = mugen::def::DefParserWin{}.parse("assets/good/kfm.def");
+  ASSERT_EQ(results[0].status, MDEF_OK);
+  EXPECT_EQ(c_item(results[0], strings, MDEF_KEY_NAME), kfm.info.name);
+  EXPECT_EQ(c_item(results[0], strings, MDEF_KEY_SPRITE), kfm.files.sprite.string());
+  EXPECT_EQ(strings[results[0].items[MDEF_KEY_NAME].offset + kfm.info.name.size()], '\0');
+  EXPECT_EQ(results[0].items[MDEF_KEY_PAL12].present != 0, kfm.files.pal12.has_value());
+  EXPECT_EQ(results[0].items[MDEF_KEY_VERSIONDATE].present, 0u);
+  ASSERT_TRUE(kfm.info.versionDate);
+  EXPECT_EQ(results[0].versionDate.present, 1);
+  EXPECT_EQ(results[0].versionDate.year, kfm.info.versionDate->year);
+
+  EXPECT_EQ(results[1].status, MDEF_ERROR_FILE_IO);
+  EXPECT_STRNE(mdef_status_message(results[1].status), mdef_status_message(MDEF_OK));
+  EXPECT_EQ(mdef_abi_version(), static_cast<uint32_t>(MDEF_ABI_VERSION));
+}
+
+TEST(test_c_api, insufficient_buffer) {
+  const char* paths[] = {"assets/good/kfm.def"};
+  mdef_result result{};
+
+  // 容量 0 で呼び出すと必要なバイト数だけがわかる
+  auto required = mdef_parse_batch(paths, 1, &result, nullptr, 0, 1);
+  EXPECT_GT(required, 0u);
+  EXPECT_EQ(result.status, MDEF_ERROR_INSUFFICIENT_BUFFER);
+
+  std::vector<char> strings(required);
+  EXPECT_EQ(mdef_parse_batch(paths, 1, &result, strings.data(), strings.size(), 1), required);
+  EXPECT_EQ(result.status, MDEF_OK);
+}
+
+#ifndef MDEFPARSER_HEADER_ONLY
+TEST(test_c_api, call_from_c) {
+  char name[64]{};
+  ASSERT_EQ(mdef_c_api_parse_name("assets/good/kfm.def", name, sizeof(name)), MDEF_OK);
+  EXPECT_STREQ(name, "Kung Fu Man");
+  EXPECT_EQ(mdef_c_api_parse_name("assets/not_found.def", name, sizeof(name)), MDEF_ERROR_FILE_IO);
+}
+#endif
@@ -0,0 +1,109 @@
+/**
+ * @file scan.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/cache.hpp>
+#include <mdefparser/mdefparser.h>
+
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "helper.hpp"
+
+namespace {
+
+std::filesystem::path write_def(const std::filesystem::path& path, const std::string& charName) {
+  return test_helper::write_text(path, "[Info]\nname = \"" + charName +
+                                           "\"\n[Files]\ncmd = a.cmd\ncns = a.cns\nst = a.cns\nsprite = a.sff\nanim = a.air\n");
+}
+
+};  // namespace
+
+TEST(test_cache, parse) {
+  mugen::def::CachingDefParser parser{};
+
+  auto first = parser.parse("assets/good/kfm.def");
+  auto second = parser.parse("assets/good/kfm.def");
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first->info.name, "Kung Fu Man");
+  // 表記の違う同じパスは同じ項目を使う
+  EXPECT_EQ(parser.parse("./assets/good/../good/kfm.def"), first);
+
+  auto stats = parser.stats();
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.size, 1);
+
+  EXPECT_EQ(parser.parse_item<mugen::def::DefParseKey::Author>("assets/good/kfm.def"), "Elecbyte");
+  EXPECT_THROW(parser.parse_item<mugen::def::DefParseKey::St0>("assets/good/kfm.def"), mugen::def::MissingKeyError);
+  // parse() に失敗するファイルからも取り出せる
+  EXPECT_EQ(parser.parse_item<mugen::def::DefParseKey::Name>("assets/bad/missing_cmd.def"), "Kung Fu Man");
+
+  EXPECT_THROW(parser.parse("assets/not-existing-file.def"), mugen::def::FileIOError);
+  EXPECT_THROW(parser.parse("assets/bad/missing_cmd.def"), mugen::def::MissingKeyError);
+  EXPECT_EQ(parser.stats().size, 1);
+
+  parser.invalidate("assets/good/kfm.def");
+  EXPECT_NE(parser.parse("assets/good/kfm.def"), first);
+}
+
+TEST(test_cache, single_flight) {
+  mugen::def::CachingDefParser parser{};
+
+  std::vector<std::shared_ptr<const mugen::def::MugenDefWin>> results(8);
+  std::vector<std::thread> threads{};
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&, i]() { results[i] = parser.parse("assets/good/kfm.def"); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& result : results) {
+    EXPECT_EQ(result, results[0]);
+  }
+  EXPECT_EQ(parser.stats().misses, 1);
+  EXPECT_EQ(parser.stats().hits, results.size() - 1);
+}
+
+TEST(test_cache, validation_and_eviction) {
+  test_helper::TempDir dir{};
+  auto path = write_def(dir / "cache.def", "Before");
+
+  mugen::def::CachingDefParser parser{2, 1};
+  EXPECT_EQ(parser.parse(path)->info.name, "Before");
+
+  // サイズが変われば読み込み直す
+  write_def(path, "After update");
+  EXPECT_EQ(parser.parse(path)->info.name, "After update");
+
+  parser.parse("assets/good/kfm.def");
+  parser.parse("assets/good/test.def");
+  auto stats = parser.stats();
+  EXPECT_EQ(stats.size, 2);
+  EXPECT_EQ(stats.evictions, 1);
+
+  parser.clear();
+  EXPECT_EQ(parser.stats().size, 0);
+}
@@ -0,0 +1,153 @@
+/**
+ * @file scan.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/catalog.hpp>
+#include <mdefparser/mdefparser.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+mugen::def::DefCatalog make_catalog() {
+  auto parser = mugen::def::DefParserWin{};
+  auto kfm = parser.parse("assets/good/kfm.def");
+
+  std::vector<mugen::def::CatalogEntry> entries{};
+  entries.push_back({"chars/kfm/kfm.def", kfm});
+
+  auto evil = kfm;
+  evil.info.name = "Evil Kung Fu Man";
+  evil.info.displayName = "Evil KFM";
+  evil.info.author = "someone";
+  evil.files.sprite = "..\\kfm\\kfm.sff";
+  entries.push_back({"chars/evilkfm/evilkfm.def", evil});
+
+  auto kfm2 = kfm;
+  kfm2.info.name = "Kung Fu Man 2";
+  kfm2.info.displayName = std::nullopt;
+  kfm2.files.sprite = "kfm2.sff";
+  entries.push_back({"chars/kfm2/kfm2.def", kfm2});
+
+  return mugen::def::DefCatalog{std::move(entries), 2};
+}
+
+};  // namespace
+
+TEST(test_catalog, find) {
+  auto catalog = make_catalog();
+  ASSERT_EQ(catalog.size(), 3);
+
+  auto byAuthor = catalog.find(mugen::def::CatalogField::Author, "elecbyte");
+  ASSERT_EQ(byAuthor.size(), 2);
+  EXPECT_EQ(byAuthor[0], 0);
+  EXPECT_EQ(byAuthor[1], 2);
+
+  auto byName = catalog.find(mugen::def::CatalogField::Name, "EVIL KUNG FU MAN");
+  ASSERT_EQ(byName.size(), 1);
+  EXPECT_EQ(catalog[byName[0]].path, "chars/evilkfm/evilkfm.def");
+
+  EXPECT_TRUE(catalog.find(mugen::def::CatalogField::Name, "Kung Fu").empty());
+  EXPECT_EQ(catalog.find(mugen::def::CatalogField::DisplayName, "kung fu man").size(), 1);
+}
+
+TEST(test_catalog, find_prefix) {
+  auto catalog = make_catalog();
+
+  auto matched = catalog.find_prefix(mugen::def::CatalogField::Name, "kung");
+  ASSERT_EQ(matched.size(), 2);
+  EXPECT_EQ(catalog[matched[0]].def.info.name, "Kung Fu Man");
+  EXPECT_EQ(catalog[matched[1]].def.info.name, "Kung Fu Man 2");
+  EXPECT_EQ(catalog.find_prefix(mugen::def::CatalogField::Name, "KUNG FU MAN ").size(), 1);
+
+  EXPECT_EQ(catalog.find_prefix(mugen::def::CatalogField::Name, "").size(), 3);
+  EXPECT_TRUE(catalog.find_prefix(mugen::def::CatalogField::Author, "zzz").empty());
+}
+
+TEST(test_catalog, cp932) {
+  auto kfm = mugen::def::DefParserWin{}.parse("assets/good/kfm.def");
+
+  // ア (0x83 0x41) と ヂ (0x83 0x61) は 2 バイト目が ASCII の A と a になる
+  std::vector<mugen::def::CatalogEntry> entries{};
+  auto a = kfm;
+  a.info.name = "\x83\x41 Man";
+  a.info.author = "\x83\x41";
+  entries.push_back({"chars/a/a.def", a});
+  auto di = kfm;
+  di.info.name = "\x83\x61 Man";
+  di.info.author = "\x83\x61";
+  entries.push_back({"chars/di/di.def", di});
+  auto catalog = mugen::def::DefCatalog{std::move(entries), 2};
+
+  auto byName = catalog.find(mugen::def::CatalogField::Name, "\x83\x41 MAN");
+  ASSERT_EQ(byName.size(), 1);
+  EXPECT_EQ(byName[0], 0);
+  byName = catalog.find(mugen::def::CatalogField::Name, "\x83\x61 man");
+  ASSERT_EQ(byName.size(), 1);
+  EXPECT_EQ(byName[0], 1);
+
+  auto byAuthor = catalog.find(mugen::def::CatalogField::Author, "\x83\x61");
+  ASSERT_EQ(byAuthor.size(), 1);
+  EXPECT_EQ(byAuthor[0], 1);
+
+  auto byPrefix = catalog.find_prefix(mugen::def::CatalogField::Name, "\x83\x41");
+  ASSERT_EQ(byPrefix.size(), 1);
+  EXPECT_EQ(byPrefix[0], 0);
+  EXPECT_EQ(catalog.find_prefix(mugen::def::CatalogField::Name, "\x83").size(), 2);
+}
+
+TEST(test_catalog, find_file) {
+  auto catalog = make_catalog();
+
+  // evilkfm は ..\kfm\kfm.sff として kfm のスプライトを参照している
+  auto users = catalog.find_file("chars/kfm/kfm.sff");
+  ASSERT_EQ(users.size(), 2);
+  EXPECT_EQ(users[0], 0);
+  EXPECT_EQ(users[1], 1);
+
+  // cns と st が同じファイルでも 1 度だけ返る
+  EXPECT_EQ(catalog.find_file("chars\\kfm2\\KFM.CNS").size(), 1);
+  EXPECT_TRUE(catalog.find_file("chars/kfm2/kfm.sff").empty());
+}
+
+TEST(test_catalog, large) {
+  auto parser = mugen::def::DefParserWin{};
+  auto kfm = parser.parse("assets/good/kfm.def");
+
+  std::vector<mugen::def::CatalogEntry> entries{};
+  for (int i = 0; i < 10000; ++i) {
+    auto def = kfm;
+    def.info.name = "char" + std::to_string(i);
+    entries.push_back({"chars/c" + std::to_string(i) + "/c.def", std::move(def)});
+  }
+
+  auto catalog = mugen::def::DefCatalog{std::move(entries)};
+  EXPECT_EQ(catalog.find(mugen::def::CatalogField::Author, "Elecbyte").size(), 10000);
+  EXPECT_EQ(catalog.find_prefix(mugen::def::CatalogField::Name, "char999").size(), 11);
+  EXPECT_EQ(catalog.find_file("chars/c42/kfm.sff").size(), 1);
+
+  // ムーブ後も索引は有効
+  auto moved = std::move(catalog);
+  EXPECT_EQ(moved.find(mugen::def::CatalogField::Name, "char42").size(), 1);
+}
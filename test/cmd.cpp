@@ -0,0 +1,77 @@
+/**
+ * @file cmd.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/cmd.hpp>
+#include <mdefparser/mdefparser.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace std::string_view_literals;
+
+static constexpr std::string_view NOT_EXISTING_FILE = "assets/not-existing-file.cmd"sv;
+
+TEST(test_cmd, common_read_error) {
+  auto reader = mugen::def::CmdReader{};
+  EXPECT_THROW(reader.read_index(NOT_EXISTING_FILE), mugen::def::FileIOError);
+}
+
+TEST(test_cmd, read_index) {
+  static constexpr std::string_view kfmcmd = "assets/good/kfm.cmd"sv;
+
+  auto reader = mugen::def::CmdReader{};
+  ASSERT_NO_THROW(reader.read_index(kfmcmd));
+  auto index = reader.read_index(kfmcmd);
+
+  // name のない [Command] は含まない
+  ASSERT_EQ(index.commands.size(), 3);
+  EXPECT_EQ(index.commands[0].name, "TripleKFPalm");
+  EXPECT_EQ(index.commands[1].name, "TripleKFPalm");
+  EXPECT_EQ(index.commands[2].name, "upper_x");
+
+  auto palms = index.find("TripleKFPalm");
+  ASSERT_EQ(palms.size(), 2);
+  EXPECT_LT(palms[0].range.begin, palms[1].range.begin);
+  EXPECT_EQ(palms[0].range.beginLine, 11);
+  EXPECT_EQ(palms[0].range.endLine, 16);
+  EXPECT_EQ(palms[0].range.end, palms[1].range.begin);
+  EXPECT_TRUE(index.find("upper_x").size() == 1);
+  EXPECT_TRUE(index.find("upper_y").empty());
+
+  ASSERT_EQ(index.stateControllers.size(), 2);
+  EXPECT_EQ(index.stateControllers[0].label, "Triple Kung Fu Palm");
+  EXPECT_EQ(index.stateControllers[0].range.beginLine, 32);
+  EXPECT_EQ(index.stateControllers[1].label, "");
+  EXPECT_EQ(index.stateControllers[1].range.endLine, 42);
+
+  std::ifstream fs{std::string{kfmcmd}, std::ios_base::binary};
+  std::stringstream ss{};
+  ss << fs.rdbuf();
+  auto text = ss.str();
+  const auto& range = index.stateControllers[1].range;
+  EXPECT_EQ(range.end, text.size());
+  EXPECT_TRUE(text.substr(range.begin).starts_with("[State -1]"));
+  EXPECT_TRUE(text.substr(index.commands[2].range.begin, index.commands[2].range.end - index.commands[2].range.begin).find("upper_x") !=
+              std::string::npos);
+}
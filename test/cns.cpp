@@ -0,0 +1,79 @@
+/**
+ * @file cns.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/cns.hpp>
+#include <mdefparser/mdefparser.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "helper.hpp"
+
+using namespace std::string_view_literals;
+
+static constexpr std::string_view NOT_EXISTING_FILE = "assets/not-existing-file.cns"sv;
+
+TEST(test_cns, common_read_error) {
+  EXPECT_THROW(mugen::def::parse_cns_constants(NOT_EXISTING_FILE), mugen::def::FileIOError);
+}
+
+TEST(test_cns, parse_constants) {
+  auto constants = mugen::def::parse_cns_constants("assets/good/kfm.cns");
+
+  ASSERT_TRUE(constants.find("data", "life"));
+  EXPECT_EQ(*constants.find("Data", "Life"), "1000");
+  EXPECT_EQ(*constants.find("data", "fall.defence_up"), "50");
+  EXPECT_EQ(constants.number("data", "power"), 3000.0);
+  EXPECT_EQ(constants.number("size", "head.pos", 1), -90.0);
+  EXPECT_FALSE(constants.number("size", "head.pos", 2));
+  EXPECT_EQ(constants.number("velocity", "run.fwd"), 4.6);
+  EXPECT_EQ(constants.number("movement", "yaccel"), .44);
+
+  // [Statedef] 以降は読まない
+  EXPECT_FALSE(constants.find("data", "unreachable"));
+  EXPECT_EQ(constants.values.back().key, "yaccel");
+}
+
+TEST(test_cns, stop_at_statedef) {
+  test_helper::TempDir dir{};
+  auto path = test_helper::write_text(dir / "statedef.cns", "[Data]\nlife = 800\n[Statedef 0]\ntype = S\n[Size]\nxscale = 2\n");
+
+  auto constants = mugen::def::parse_cns_constants(path);
+  EXPECT_EQ(constants.number("data", "life"), 800.0);
+  EXPECT_FALSE(constants.find("size", "xscale"));
+}
+
+TEST(test_cns, parse_constants_batch) {
+  auto kfm = mugen::def::DefParserWin{}.parse("assets/good/kfm.def");
+  std::vector<mugen::def::CatalogEntry> entries{};
+  entries.push_back({"assets/good/kfm.def", kfm});
+  entries.push_back({"assets/bad/kfm.def", kfm});
+
+  auto results = mugen::def::parse_cns_constants_batch(entries, 2);
+  ASSERT_EQ(results.size(), 2);
+  ASSERT_TRUE(results[0]);
+  EXPECT_EQ(results[0].value->number("data", "attack"), 100.0);
+  EXPECT_FALSE(results[1]);
+  EXPECT_TRUE(results[1].error);
+}
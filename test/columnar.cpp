@@ -0,0 +1,96 @@
+/**
+ * @file scan.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/columnar.hpp>
+#include <mdefparser/mdefparser.h>
+
+#include <map>
+#include <vector>
+
+namespace {
+
+std::vector<mugen::def::MugenDefWin> make_defs() {
+  auto parser = mugen::def::DefParserWin{};
+  auto kfm = parser.parse("assets/good/kfm.def");
+
+  std::vector<mugen::def::MugenDefWin> defs{kfm, kfm, parser.parse("assets/good/test.def")};
+  defs[1].info.mugenVersion = mugen::def::MugenDefVersion{.month = 1, .day = 1, .year = 2011};
+  defs[1].info.palDefaults = std::nullopt;
+  defs[1].files.st0 = "extra.st";
+  return defs;
+}
+
+};  // namespace
+
+TEST(test_columnar, columns) {
+  auto defs = make_defs();
+  mugen::def::ColumnarCatalog catalog{defs};
+  ASSERT_EQ(catalog.size(), defs.size());
+
+  const auto& names = catalog.column<mugen::def::DefParseKey::Name>();
+  EXPECT_EQ(names.view(0), "Kung Fu Man");
+  EXPECT_EQ(names.presence.count(), defs.size());
+
+  // mugenversion の年ごとの件数
+  const auto& versions = catalog.column<mugen::def::DefParseKey::MugenVersion>();
+  std::map<std::int32_t, std::size_t> histogram{};
+  for (std::size_t i = 0; i < catalog.size(); ++i) {
+    if (versions.presence.test(i)) {
+      ++histogram[versions.years[i]];
+    }
+  }
+  EXPECT_EQ(histogram[2011], 1);
+  EXPECT_EQ(histogram[2002], 1);
+  // test.def の mugenversion は day が不正なので year は読み込まれない
+  EXPECT_EQ(histogram[0], 1);
+
+  EXPECT_EQ(catalog.presence(mugen::def::DefParseKey::St0).count(), 1);
+  EXPECT_TRUE(catalog.presence(mugen::def::DefParseKey::St0).test(1));
+
+  const auto& palDefaults = catalog.column<mugen::def::DefParseKey::PalDefaults>();
+  EXPECT_FALSE(palDefaults.presence.test(1));
+  EXPECT_TRUE(palDefaults.view(1).empty());
+  ASSERT_EQ(palDefaults.view(0).size(), 4);
+  EXPECT_EQ(palDefaults.view(0)[0], 6);
+}
+
+TEST(test_columnar, row) {
+  auto defs = make_defs();
+  mugen::def::ColumnarCatalog catalog{};
+  for (const auto& def : defs) {
+    catalog.append(def);
+  }
+
+  for (std::size_t i = 0; i < defs.size(); ++i) {
+    auto row = catalog.row(i);
+    EXPECT_EQ(row.info.name, defs[i].info.name);
+    EXPECT_EQ(row.info.author, defs[i].info.author);
+    EXPECT_EQ(row.info.palDefaults, defs[i].info.palDefaults);
+    EXPECT_EQ(row.info.mugenVersion.has_value(), defs[i].info.mugenVersion.has_value());
+    EXPECT_EQ(row.files.sprite, defs[i].files.sprite);
+    EXPECT_EQ(row.files.st0, defs[i].files.st0);
+    EXPECT_EQ(row.arcade.intro, defs[i].arcade.intro);
+  }
+  EXPECT_EQ(catalog.row(1).info.mugenVersion->year, 2011);
+  EXPECT_THROW(catalog.row(defs.size()), std::out_of_range);
+}
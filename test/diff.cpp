@@ -0,0 +1,91 @@
+/**
+ * @file diff.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/diff.hpp>
+#include <mdefparser/mdefparser.h>
+
+#include <string>
+#include <vector>
+
+TEST(test_diff, diff_catalogs) {
+  auto kfm = mugen::def::DefParserWin{}.parse("assets/good/kfm.def");
+
+  std::vector<mugen::def::CatalogEntry> before{};
+  before.push_back({"chars/kfm/kfm.def", kfm});
+  before.push_back({"chars/removed/removed.def", kfm});
+  before.push_back({"chars/changed/changed.def", kfm});
+
+  std::vector<mugen::def::CatalogEntry> after{};
+  auto changed = kfm;
+  changed.info.author = "someone";
+  changed.info.versionDate = mugen::def::MugenDefVersion{.month = 1, .day = 2, .year = 2026};
+  changed.files.pal3 = std::nullopt;
+  after.push_back({"chars/changed/changed.def", changed});
+  after.push_back({"chars/added/added.def", kfm});
+  // 区切り文字が異なっても同じパスとして扱う
+  after.push_back({"chars\\kfm\\kfm.def", kfm});
+
+  auto diffs = mugen::def::diff_catalogs(before, after, 2);
+  ASSERT_EQ(diffs.size(), 3);
+
+  // パスの順に並ぶ
+  EXPECT_EQ(diffs[0].kind, mugen::def::DiffKind::Added);
+  EXPECT_EQ(diffs[0].before, mugen::def::CatalogDiff::npos);
+  EXPECT_EQ(diffs[0].after, 1);
+
+  EXPECT_EQ(diffs[1].kind, mugen::def::DiffKind::Changed);
+  EXPECT_EQ(diffs[1].before, 2);
+  EXPECT_EQ(diffs[1].after, 0);
+  mugen::def::DefKeySet keys{};
+  keys.set(static_cast<std::size_t>(mugen::def::DefParseKey::Author));
+  keys.set(static_cast<std::size_t>(mugen::def::DefParseKey::VersionDate));
+  keys.set(static_cast<std::size_t>(mugen::def::DefParseKey::Pal3));
+  EXPECT_EQ(diffs[1].changedKeys, keys);
+
+  EXPECT_EQ(diffs[2].kind, mugen::def::DiffKind::Removed);
+  EXPECT_EQ(diffs[2].before, 1);
+  EXPECT_EQ(diffs[2].after, mugen::def::CatalogDiff::npos);
+}
+
+TEST(test_diff, storyboard_and_duplicates) {
+  auto kfm = mugen::def::DefParserWin{}.parse("assets/good/kfm.def");
+
+  auto withStoryboard = kfm;
+  withStoryboard.arcade.introStoryboard = mugen::def::StoryboardDef{.sprite = "intro.sff", .sound = std::nullopt, .sceneCount = 3};
+
+  // 同じパスが複数ある場合は現れた順に対応させる
+  std::vector<mugen::def::CatalogEntry> before{{"a.def", kfm}, {"a.def", kfm}};
+  std::vector<mugen::def::CatalogEntry> after{{"a.def", kfm}, {"a.def", withStoryboard}, {"a.def", kfm}};
+
+  auto diffs = mugen::def::diff_catalogs(before, after);
+  ASSERT_EQ(diffs.size(), 2);
+  EXPECT_EQ(diffs[0].kind, mugen::def::DiffKind::Changed);
+  EXPECT_EQ(diffs[0].after, 1);
+  EXPECT_TRUE(diffs[0].changedKeys.test(static_cast<std::size_t>(mugen::def::DefParseKey::Intro)));
+  EXPECT_EQ(diffs[0].changedKeys.count(), 1);
+  EXPECT_EQ(diffs[1].kind, mugen::def::DiffKind::Added);
+  EXPECT_EQ(diffs[1].after, 2);
+
+  EXPECT_TRUE(mugen::def::diff_catalogs(before, before).empty());
+  EXPECT_TRUE(mugen::def::diff_catalogs({}, {}).empty());
+}
@@ -0,0 +1,139 @@
+/**
+ * @file scan.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/fingerprint.hpp>
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/source.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "helper.hpp"
+
+namespace {
+
+// kfm.def と参照先のダミーファイルを dir に作る
+std::filesystem::path make_package(const test_helper::TempDir& root, const std::string& name, std::string_view sprite) {
+  auto dir = root / name;
+  std::filesystem::create_directories(dir);
+  std::filesystem::copy_file("assets/good/kfm.def", dir / "kfm.def", std::filesystem::copy_options::overwrite_existing);
+  test_helper::write_text(dir / "kfm.cmd", "[Command]\nname = \"a\"\n");
+  test_helper::write_text(dir / "kfm.cns", "[Data]\nlife = 1000\n");
+  test_helper::write_text(dir / "kfm.sff", sprite);
+  test_helper::write_text(dir / "kfm.air", "[Begin Action 0]\n0,0, 0,0, -1\n");
+  return dir / "kfm.def";
+}
+
+};  // namespace
+
+TEST(test_fingerprint, xxh64) {
+  EXPECT_EQ(mugen::def::xxh64({}), 0xef46db3751d8e999ULL);
+
+  std::string_view abc = "abc";
+  EXPECT_EQ(mugen::def::xxh64(std::as_bytes(std::span{abc})), 0x44bc2cf5ad770999ULL);
+
+  std::string_view name = "Kung Fu Man";
+  EXPECT_EQ(mugen::def::xxh64(std::as_bytes(std::span{name}), 1), 0xfa61c5f28ffb264eULL);
+}
+
+TEST(test_fingerprint, fingerprint) {
+  test_helper::TempDir dir{};
+  auto path = make_package(dir, "a", "sprite data");
+  auto def = mugen::def::DefParserWin{}.parse(path);
+
+  auto hasher = mugen::def::PackageHasher{};
+  auto fingerprint = hasher.fingerprint(path, def, 2);
+  ASSERT_FALSE(fingerprint.files.empty());
+  EXPECT_EQ(fingerprint.files[0].path, path);
+  EXPECT_TRUE(fingerprint.files[0].exists);
+
+  // cns と st は同じファイルなので 1 度だけ含まれる
+  std::size_t cnsCount = 0;
+  for (const auto& file : fingerprint.files) {
+    if (file.path.filename() == "kfm.cns") {
+      ++cnsCount;
+      EXPECT_TRUE(file.exists);
+    }
+    if (file.path.filename() == "kfm.snd") {
+      EXPECT_FALSE(file.exists);
+    }
+  }
+  EXPECT_EQ(cnsCount, 1);
+
+  EXPECT_EQ(hasher.fingerprint(path, def, 1).hash, fingerprint.hash);
+  EXPECT_THROW(hasher.fingerprint("assets/not-existing-dir/kfm.def", def), mugen::def::FileIOError);
+}
+
+TEST(test_fingerprint, source) {
+  test_helper::TempDir dir{};
+  auto path = make_package(dir, "a", "sprite data");
+  auto expected = mugen::def::PackageHasher{}.fingerprint(path, mugen::def::DefParserWin{}.parse(path));
+
+  // ディスク上には存在しないパスでも source 経由で読み込む
+  auto memory = std::make_shared<mugen::def::MemoryFileSource>();
+  for (const auto* name : {"kfm.def", "kfm.cmd", "kfm.cns", "kfm.sff", "kfm.air"}) {
+    memory->add(std::filesystem::path{"chars/kfm"} / name, test_helper::read_text(path.parent_path() / name));
+  }
+  std::vector<std::filesystem::path> paths{"chars/kfm/kfm.def"};
+
+  auto parser = mugen::def::DefParserWin{memory};
+  auto results = mugen::def::PackageHasher{}.fingerprint_batch(paths, parser, 1);
+  ASSERT_TRUE(results[0]);
+  EXPECT_EQ(results[0].value->hash, expected.hash);
+
+  auto hasher = mugen::def::PackageHasher{memory};
+  EXPECT_EQ(hasher.fingerprint(paths[0], parser.parse(paths[0])).hash, expected.hash);
+  EXPECT_THROW(hasher.fingerprint(path, parser.parse(paths[0])), mugen::def::FileIOError);
+}
+
+TEST(test_fingerprint, group_duplicates) {
+  test_helper::TempDir dir{};
+  std::vector<std::filesystem::path> paths{
+      make_package(dir, "original", "sprite data"),
+      make_package(dir, "modified", "other sprite data"),
+      "assets/not-existing-file.def",
+      make_package(dir, "reupload", "sprite data"),
+  };
+
+  auto hasher = mugen::def::PackageHasher{};
+  auto parser = mugen::def::DefParserWin{};
+  auto results = hasher.fingerprint_batch(paths, parser, 2);
+  ASSERT_EQ(results.size(), 4);
+  EXPECT_TRUE(results[0]);
+  EXPECT_FALSE(results[2]);
+  EXPECT_NE(results[0].value->hash, results[1].value->hash);
+  EXPECT_EQ(results[0].value->hash, results[3].value->hash);
+
+  auto groups = mugen::def::group_duplicates(results);
+  ASSERT_EQ(groups.size(), 1);
+  EXPECT_EQ(groups[0], (std::vector<std::size_t>{0, 3}));
+
+  // def は渡したパーサーの制限でパースされる
+  auto limited = mugen::def::DefParserWin{mugen::def::ParseLimits{.maxFileSize = 1}};
+  auto rejected = hasher.fingerprint_batch(paths, limited, 2);
+  ASSERT_FALSE(rejected[0]);
+  EXPECT_THROW(std::rethrow_exception(rejected[0].error), mugen::def::LimitExceededError);
+}
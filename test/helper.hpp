@@ -0,0 +1,92 @@
+/**
+ * @file helper.hpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MDEFPARSER_TEST_HELPER_HPP__
+#define MDEFPARSER_TEST_HELPER_HPP__
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace test_helper {
+
+// テストごとの一時フォルダ
+// 通常版とヘッダーオンリー版のテストを同時に実行しても重ならないよう、テスト名と乱数から名前を作る
+// 破棄時に中身ごと削除する
+class TempDir {
+ public:
+  TempDir(const TempDir&) = delete;
+  TempDir& operator=(const TempDir&) = delete;
+
+  explicit TempDir() : path_{make_path()} {
+    std::filesystem::create_directories(path_);
+  }
+
+  ~TempDir() {
+    std::error_code ec{};
+    std::filesystem::remove_all(path_, ec);
+  }
+
+  const std::filesystem::path& path() const noexcept {
+    return path_;
+  }
+
+  std::filesystem::path operator/(const std::filesystem::path& name) const {
+    return path_ / name;
+  }
+
+ private:
+  static std::filesystem::path make_path() {
+    std::string name = "mdefparser";
+    if (const auto* info = ::testing::UnitTest::GetInstance()->current_test_info()) {
+      name = name + "-" + info->test_suite_name() + "-" + info->name();
+    }
+    name += "-" + std::to_string(std::random_device{}());
+    return std::filesystem::temp_directory_path() / name;
+  }
+
+  std::filesystem::path path_;
+};
+
+// 親フォルダがなければ作る
+inline std::filesystem::path write_text(const std::filesystem::path& path, std::string_view text) {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream fs{path, std::ios_base::binary};
+  fs.write(text.data(), static_cast<std::streamsize>(text.size()));
+  return path;
+}
+
+inline std::string read_text(const std::filesystem::path& path) {
+  std::ifstream fs{path, std::ios_base::binary};
+  std::ostringstream out{};
+  out << fs.rdbuf();
+  return out.str();
+}
+
+};  // namespace test_helper
+
+#endif  // MDEFPARSER_TEST_HELPER_HPP__
@@ -0,0 +1,111 @@
+/**
+ * @file scan.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/intern.hpp>
+#include <mdefparser/mdefparser.h>
+
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(test_intern, string_pool) {
+  mugen::def::StringPool pool{5};
+
+  auto a = pool.intern("common1.cns");
+  auto b = pool.intern("kfm.act");
+  auto c = pool.intern(std::string{"common1.cns"});
+  EXPECT_EQ(a, c);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(pool.size(), 2);
+  EXPECT_EQ(pool.view(a), "common1.cns");
+  EXPECT_EQ(pool.view(b), "kfm.act");
+  EXPECT_EQ(pool.find("kfm.act"), b);
+  EXPECT_FALSE(pool.find("kfm.cmd"));
+  EXPECT_THROW(pool.view(mugen::def::StringPool::npos), std::out_of_range);
+
+  // 大きな文字列も保持できる
+  std::string large(0x20000, 'x');
+  EXPECT_EQ(pool.view(pool.intern(large)), large);
+  EXPECT_EQ(pool.view(pool.intern("")), "");
+}
+
+TEST(test_intern, concurrent_intern) {
+  mugen::def::StringPool pool{};
+
+  std::vector<std::vector<mugen::def::StringHandle>> handles(4);
+  std::vector<std::thread> threads{};
+  for (std::size_t t = 0; t < handles.size(); ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < 1000; ++i) {
+        handles[t].push_back(pool.intern("pal" + std::to_string(i % 100) + ".act"));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(pool.size(), 100);
+  for (std::size_t t = 1; t < handles.size(); ++t) {
+    EXPECT_EQ(handles[t], handles[0]);
+  }
+  EXPECT_EQ(pool.view(handles[0][42]), "pal42.act");
+}
+
+TEST(test_intern, intern_def) {
+  auto parser = mugen::def::DefParserWin{};
+  auto def = parser.parse("assets/good/kfm.def");
+
+  mugen::def::StringPool pool{};
+  auto interned = mugen::def::intern(def, pool);
+  EXPECT_TRUE(interned.has(mugen::def::DefParseKey::Name));
+  EXPECT_TRUE(interned.has(mugen::def::DefParseKey::PalDefaults));
+  EXPECT_FALSE(interned.has(mugen::def::DefParseKey::St0));
+  // cns と st は同じファイル名なので同じハンドルになる
+  EXPECT_EQ(interned.items[static_cast<std::size_t>(mugen::def::DefParseKey::Cns)],
+            interned.items[static_cast<std::size_t>(mugen::def::DefParseKey::St)]);
+
+  auto restored = mugen::def::materialize(interned, pool);
+  EXPECT_EQ(restored.info.name, def.info.name);
+  EXPECT_EQ(restored.info.versionDate->year, 2007);
+  EXPECT_EQ(restored.info.palDefaults, def.info.palDefaults);
+  EXPECT_EQ(restored.files.stcommon, def.files.stcommon);
+  EXPECT_EQ(restored.files.ai, def.files.ai);
+  EXPECT_FALSE(restored.files.st0);
+  EXPECT_EQ(restored.arcade.ending, def.arcade.ending);
+}
+
+TEST(test_intern, parse_batch_interned) {
+  std::vector<std::filesystem::path> paths{"assets/good/kfm.def", "assets/bad/missing_cmd.def", "assets/good/kfm.def"};
+
+  auto parser = mugen::def::DefParserWin{};
+  mugen::def::StringPool pool{};
+  auto results = mugen::def::parse_batch_interned(parser, paths, pool, 2);
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_TRUE(results[0]);
+  EXPECT_FALSE(results[1]);
+  EXPECT_THROW(std::rethrow_exception(results[1].error), mugen::def::MissingKeyError);
+  EXPECT_EQ(results[0].value->items, results[2].value->items);
+  EXPECT_EQ(mugen::def::materialize(*results[2].value, pool).info.author, "Elecbyte");
+}
@@ -0,0 +1,170 @@
+/**
+ * @file scan.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/source.hpp>
+
+#include <filesystem>
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "helper.hpp"
+
+namespace {
+
+// read_at() の呼び出し回数を数える
+class CountingSource : public mugen::def::FileSource {
+ public:
+  std::optional<mugen::def::FileStat> stat(const std::filesystem::path& path) const override {
+    return source_.stat(path);
+  }
+
+  std::unique_ptr<mugen::def::FileHandle> open(const std::filesystem::path& path) const override {
+    return std::make_unique<Handle>(source_.open(path), reads);
+  }
+
+  mutable std::atomic<std::size_t> reads{0};
+
+ private:
+  class Handle : public mugen::def::FileHandle {
+   public:
+    Handle(std::unique_ptr<mugen::def::FileHandle> handle, std::atomic<std::size_t>& reads) : handle_{std::move(handle)}, reads_{reads} {}
+
+    std::uint64_t size() const noexcept override {
+      return handle_->size();
+    }
+
+    std::size_t read_at(std::uint64_t offset, void* buffer, std::size_t length) const override {
+      ++reads_;
+      return handle_->read_at(offset, buffer, length);
+    }
+
+   private:
+    std::unique_ptr<mugen::def::FileHandle> handle_;
+    std::atomic<std::size_t>& reads_;
+  };
+
+  mugen::def::PreadFileSource source_{};
+};
+
+const std::string MINIMAL_DEF =
+    "[Info]\r\nname = \"Kung Fu Man\"\r\n[Files]\r\ncmd = kfm.cmd\r\ncns = kfm.cns\r\nst = kfm.cns\r\nsprite = kfm.sff\r\nanim = kfm.air\r\n";
+
+};  // namespace
+
+TEST(test_limits, default_limits) {
+  test_helper::TempDir dir{};
+  auto parser = mugen::def::DefParserWin{};
+  EXPECT_EQ(parser.limits().maxFileSize, mugen::def::ParseLimits{}.maxFileSize);
+
+  // CRLF の行末も取り除かれる
+  auto def = parser.parse(test_helper::write_text(dir / "crlf.def", MINIMAL_DEF));
+  EXPECT_EQ(def.info.name, "Kung Fu Man");
+  EXPECT_EQ(def.files.anim, "kfm.air");
+}
+
+TEST(test_limits, file_size) {
+  auto parser = mugen::def::DefParserWin{mugen::def::ParseLimits{.maxFileSize = 16}};
+  EXPECT_THROW(parser.parse("assets/good/kfm.def"), mugen::def::LimitExceededError);
+  EXPECT_THROW(parser.parse_item<mugen::def::DefParseKey::Name>("assets/good/kfm.def"), mugen::def::LimitExceededError);
+
+  parser.set_limits(mugen::def::ParseLimits{});
+  EXPECT_NO_THROW(parser.parse("assets/good/kfm.def"));
+}
+
+TEST(test_limits, line_length) {
+  test_helper::TempDir dir{};
+  // 改行を含まないバイナリのようなファイル
+  auto path = test_helper::write_text(dir / "line.def", std::string(0x40000, 'x'));
+
+  auto parser = mugen::def::DefParserWin{};
+  EXPECT_THROW(parser.parse(path), mugen::def::LimitExceededError);
+  EXPECT_THROW(parser.parse_item<mugen::def::DefParseKey::Name>(path), mugen::def::LimitExceededError);
+}
+
+TEST(test_limits, scan_bytes) {
+  test_helper::TempDir dir{};
+  std::string text{};
+  for (int i = 0; i < 1000; ++i) {
+    text += "; padding comment line\n";
+  }
+  auto path = test_helper::write_text(dir / "scan.def", text + MINIMAL_DEF);
+
+  auto parser = mugen::def::DefParserWin{mugen::def::ParseLimits{.maxScanBytes = 4096}};
+  EXPECT_THROW(parser.parse(path), mugen::def::LimitExceededError);
+  EXPECT_THROW(parser.parse_item<mugen::def::DefParseKey::Cmd>(path), mugen::def::LimitExceededError);
+
+  // 必須セクションが揃った後は制限しない
+  auto trailing = test_helper::write_text(dir / "scan_trailing.def", MINIMAL_DEF + text);
+  EXPECT_EQ(parser.parse(trailing).info.name, "Kung Fu Man");
+}
+
+TEST(test_limits, sections) {
+  test_helper::TempDir dir{};
+  std::string text{};
+  for (int i = 0; i < 100; ++i) {
+    text += "[State " + std::to_string(i) + "]\n";
+  }
+  auto path = test_helper::write_text(dir / "sections.def", text + MINIMAL_DEF);
+
+  auto parser = mugen::def::DefParserWin{mugen::def::ParseLimits{.maxSections = 10}};
+  EXPECT_THROW(parser.parse(path), mugen::def::LimitExceededError);
+
+  parser.set_limits(mugen::def::ParseLimits{.maxSections = 200});
+  EXPECT_EQ(parser.parse(path).files.cmd, "kfm.cmd");
+}
+
+TEST(test_limits, prefix_bytes) {
+  test_helper::TempDir dir{};
+  std::string comments{};
+  for (int i = 0; i < 4000; ++i) {
+    comments += "; padding comment line\n";
+  }
+  auto trailing = test_helper::write_text(dir / "prefix.def", MINIMAL_DEF + comments + "[Arcade]\nintro.storyboard = intro.def\n");
+
+  auto source = std::make_shared<CountingSource>();
+  auto parser = mugen::def::DefParserWin{source, mugen::def::ParseLimits{.prefixBytes = 8192}};
+
+  // 必須セクションが揃っていれば最初の 1 回の読み込みで終える
+  auto def = parser.parse(trailing);
+  EXPECT_EQ(def.info.name, "Kung Fu Man");
+  EXPECT_FALSE(def.arcade.intro);
+  EXPECT_EQ(source->reads, 1);
+  EXPECT_THROW(parser.parse_item<mugen::def::DefParseKey::Intro>(trailing), mugen::def::MissingKeyError);
+
+  source->reads = 0;
+  EXPECT_EQ(parser.parse("assets/good/kfm.def").info.name, "Kung Fu Man");
+  EXPECT_EQ(source->reads, 1);
+
+  // 揃っていなければ続きを読み込む
+  auto leading = test_helper::write_text(dir / "prefix_leading.def", comments + MINIMAL_DEF);
+  source->reads = 0;
+  EXPECT_EQ(parser.parse(leading).files.anim, "kfm.air");
+  EXPECT_GT(source->reads, 1);
+
+  // prefixBytes == 0 の場合はファイル全体を読む
+  parser.set_limits(mugen::def::ParseLimits{});
+  EXPECT_EQ(parser.parse(trailing).arcade.intro, "intro.def");
+  EXPECT_EQ(parser.parse_item<mugen::def::DefParseKey::Intro>(trailing), "intro.def");
+}
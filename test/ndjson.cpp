@@ -0,0 +1,97 @@
+/**
+ * @file ndjson.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/ndjson.hpp>
+
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::string_view_literals;
+
+TEST(test_ndjson, write_kfm) {
+  static constexpr std::string_view kfmdef = "assets/good/kfm.def"sv;
+
+  auto parser = mugen::def::DefParserWin{};
+  auto def = parser.parse(kfmdef);
+
+  std::ostringstream out{};
+  auto writer = mugen::def::NdjsonWriter{out};
+  writer.write(kfmdef, def);
+
+  auto line = out.str();
+  EXPECT_EQ(line.find("{\"path\":\"assets/good/kfm.def\",\"name\":\"Kung Fu Man\",\"displayname\":\"Kung Fu Man\""), 0);
+  EXPECT_NE(line.find(",\"versiondate\":[12,27,2007],"), std::string::npos);
+  EXPECT_NE(line.find(",\"pal.defaults\":[6,3,4,2],"), std::string::npos);
+  EXPECT_NE(line.find(",\"stcommon\":\"common1.cns\","), std::string::npos);
+  EXPECT_NE(line.find(",\"ending.storyboard\":\"ending.def\"}\n"), std::string::npos);
+  EXPECT_EQ(line.find("\"st0\""), std::string::npos);
+  EXPECT_EQ(line.find('\n'), line.size() - 1);
+}
+
+TEST(test_ndjson, escape) {
+  auto def = mugen::def::MugenDefWin{};
+  def.info.name = "a\"b\\c\td\x01";
+  // "日本" in UTF-8 is kept as is
+  def.info.displayName = "\xE6\x97\xA5\xE6\x9C\xAC";
+  // "ソ" in CP932 has 0x5C as the second byte
+  def.info.author = "\x83\x5C";
+
+  std::ostringstream out{};
+  auto writer = mugen::def::NdjsonWriter{out};
+  writer.write("x.def", def);
+
+  auto line = out.str();
+  EXPECT_NE(line.find("\"name\":\"a\\\"b\\\\c\\td\\u0001\""), std::string::npos);
+  EXPECT_NE(line.find("\"displayname\":\"\xE6\x97\xA5\xE6\x9C\xAC\""), std::string::npos);
+  EXPECT_NE(line.find("\"author\":\"\\u0083\\\\\",\"authorEncoding\":\"bytes\""), std::string::npos);
+  // 印はバイト単位でエスケープした値にのみ付く
+  EXPECT_EQ(line.find("\"nameEncoding\""), std::string::npos);
+  EXPECT_EQ(line.find("\"displaynameEncoding\""), std::string::npos);
+}
+
+TEST(test_ndjson, export_batch) {
+  std::vector<std::filesystem::path> paths{"assets/good/kfm.def", "assets/good/test.def", "assets/bad/missing_cmd.def",
+                                           "assets/not-existing-file.def"};
+
+  std::ostringstream out{};
+  auto summary = mugen::def::export_ndjson(paths, out, 2);
+  EXPECT_EQ(summary.succeeded, 2);
+  EXPECT_EQ(summary.failed, 2);
+
+  std::istringstream in{out.str()};
+  std::size_t lines = 0;
+  std::size_t errors = 0;
+  for (std::string line; std::getline(in, line);) {
+    ++lines;
+    EXPECT_EQ(line.front(), '{');
+    EXPECT_EQ(line.back(), '}');
+    if (line.find("\"error\":") != std::string::npos) {
+      ++errors;
+    }
+  }
+  EXPECT_EQ(lines, 4);
+  EXPECT_EQ(errors, 2);
+}
@@ -0,0 +1,101 @@
+/**
+ * @file palette.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/palette.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include "helper.hpp"
+
+namespace {
+
+// 色番号 n の色を (n, n + 1, n + 2) とした ACT
+void write_act(const std::filesystem::path& path, std::size_t size) {
+  std::vector<char> buf(size, '\0');
+  for (std::size_t i = 0; i < 256 && (255 - i) * 3 + 2 < size; ++i) {
+    buf[(255 - i) * 3 + 0] = static_cast<char>(i);
+    buf[(255 - i) * 3 + 1] = static_cast<char>(i + 1);
+    buf[(255 - i) * 3 + 2] = static_cast<char>(i + 2);
+  }
+  test_helper::write_text(path, std::string_view{buf.data(), buf.size()});
+}
+
+};  // namespace
+
+TEST(test_palette, read) {
+  test_helper::TempDir dir{};
+  auto path = dir / "palette.act";
+  write_act(path, 772);
+
+  auto rgba = mugen::def::ActReader{}.read(path);
+  ASSERT_EQ(rgba.size(), mugen::def::RGBA_PALETTE_SIZE);
+  EXPECT_EQ(rgba[3], 0);
+  for (std::size_t i = 1; i < 256; ++i) {
+    EXPECT_EQ(rgba[i * 4 + 0], static_cast<std::uint8_t>(i));
+    EXPECT_EQ(rgba[i * 4 + 1], static_cast<std::uint8_t>(i + 1));
+    EXPECT_EQ(rgba[i * 4 + 2], static_cast<std::uint8_t>(i + 2));
+    EXPECT_EQ(rgba[i * 4 + 3], 0xFF);
+  }
+
+  write_act(path, 100);
+  EXPECT_THROW(mugen::def::ActReader{}.read(path), mugen::def::InvalidFormatError);
+}
+
+TEST(test_palette, read_palettes) {
+  test_helper::TempDir dir{};
+  std::filesystem::create_directories(dir / "b");
+  write_act(dir / "a" / "1.act", 768);
+  write_act(dir / "shared.act", 768);
+
+  auto kfm = mugen::def::DefParserWin{}.parse("assets/good/kfm.def");
+  std::vector<mugen::def::CatalogEntry> entries{};
+  entries.push_back({dir / "a" / "a.def", kfm});
+  entries.push_back({dir / "b" / "b.def", kfm});
+  entries[0].def.files = {};
+  entries[0].def.files.pal1 = "1.act";
+  entries[0].def.files.pal3 = "..\\shared.act";
+  entries[1].def.files = {};
+  entries[1].def.files.pal1 = "../shared.act";
+  entries[1].def.files.pal2 = "missing.act";
+
+  auto palettes = mugen::def::ActReader{}.read_palettes(entries, 2);
+  ASSERT_EQ(palettes.files.size(), 3u);
+  ASSERT_EQ(palettes.rgba.size(), 3 * mugen::def::RGBA_PALETTE_SIZE);
+  ASSERT_EQ(palettes.slots.size(), 2 * mugen::def::PALETTE_SLOT_COUNT);
+
+  EXPECT_EQ(palettes.slots[0], 0u);
+  EXPECT_EQ(palettes.slots[1], mugen::def::PaletteSet::npos);
+  EXPECT_EQ(palettes.slots[2], 1u);
+  EXPECT_EQ(palettes.slots[mugen::def::PALETTE_SLOT_COUNT + 0], 1u);
+  EXPECT_EQ(palettes.slots[mugen::def::PALETTE_SLOT_COUNT + 1], 2u);
+
+  EXPECT_FALSE(palettes.errors[0]);
+  EXPECT_FALSE(palettes.errors[1]);
+  EXPECT_TRUE(palettes.errors[2]);
+  EXPECT_EQ(palettes.palette(1)[255 * 4], 255);
+  EXPECT_EQ(palettes.palette(2)[255 * 4], 0);
+}
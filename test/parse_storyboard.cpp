@@ -0,0 +1,137 @@
+/**
+ * @file parse_storyboard.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/async.hpp>
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/storyboard.hpp>
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "helper.hpp"
+
+using namespace std::string_view_literals;
+
+static constexpr std::string_view NOT_EXISTING_FILE = "assets/not-existing-file.def"sv;
+
+TEST(test_parse_storyboard, common_parse_error) {
+  auto parser = mugen::def::StoryboardParser{};
+  EXPECT_ANY_THROW(parser.parse(NOT_EXISTING_FILE));
+  EXPECT_THROW(parser.parse(NOT_EXISTING_FILE), mugen::def::FileIOError);
+}
+
+TEST(test_parse_storyboard, parse_intro) {
+  static constexpr std::string_view introdef = "assets/good/intro.def"sv;
+
+  auto parser = mugen::def::StoryboardParser{};
+  ASSERT_NO_THROW(parser.parse(introdef));
+
+  auto storyboard = parser.parse(introdef);
+  EXPECT_EQ(storyboard.sprite, "intro.sff");
+  EXPECT_TRUE(storyboard.sound);
+  if (storyboard.sound) {
+    EXPECT_EQ(*(storyboard.sound), "intro.snd");
+  }
+  EXPECT_EQ(storyboard.sceneCount, 2);
+}
+
+TEST(test_parse_storyboard, parse_ending) {
+  static constexpr std::string_view endingdef = "assets/good/ending.def"sv;
+
+  auto parser = mugen::def::StoryboardParser{};
+  ASSERT_NO_THROW(parser.parse(endingdef));
+
+  auto storyboard = parser.parse(endingdef);
+  EXPECT_EQ(storyboard.sprite, "ending.sff");
+  EXPECT_FALSE(storyboard.sound);
+  EXPECT_EQ(storyboard.sceneCount, 3);
+}
+
+TEST(test_parse_storyboard, missing_spr) {
+  static constexpr std::string_view missing_spr_def = "assets/bad/missing_spr.def"sv;
+
+  auto parser = mugen::def::StoryboardParser{};
+  EXPECT_THROW(parser.parse(missing_spr_def), mugen::def::MissingKeyError);
+}
+
+TEST(test_parse_storyboard, follow_arcade_kfm) {
+  static constexpr std::string_view kfmdef = "assets/good/kfm.def"sv;
+
+  auto parser = mugen::def::DefParserWin{};
+
+  auto def = parser.parse(kfmdef);
+  EXPECT_FALSE(def.arcade.introStoryboard);
+  EXPECT_FALSE(def.arcade.endingStoryboard);
+
+  ASSERT_NO_THROW(mugen::def::parse(parser, kfmdef, {.followArcade = true}));
+  def = mugen::def::parse(parser, kfmdef, {.followArcade = true});
+
+  EXPECT_EQ(def.info.name, "Kung Fu Man");
+
+  EXPECT_TRUE(def.arcade.introStoryboard);
+  if (def.arcade.introStoryboard) {
+    EXPECT_EQ(def.arcade.introStoryboard->sprite, "intro.sff");
+    EXPECT_EQ(def.arcade.introStoryboard->sceneCount, 2);
+  }
+
+  EXPECT_TRUE(def.arcade.endingStoryboard);
+  if (def.arcade.endingStoryboard) {
+    EXPECT_EQ(def.arcade.endingStoryboard->sprite, "ending.sff");
+    EXPECT_EQ(def.arcade.endingStoryboard->sceneCount, 3);
+  }
+}
+
+TEST(test_parse_storyboard, follow_arcade_missing_reference) {
+  test_helper::TempDir dir{};
+  std::filesystem::create_directories(dir / "intro");
+  std::filesystem::copy_file("assets/good/intro.def", dir / "intro" / "intro.def");
+  test_helper::write_text(dir / "bad.def", "[SceneDef]\nsnd = bad.snd\n[Scene 0]\n");
+
+  static constexpr std::string_view files = "[Files]\ncmd = kfm.cmd\ncns = kfm.cns\nst = kfm.cns\nsprite = kfm.sff\nanim = kfm.air\n";
+  auto parser = mugen::def::DefParserWin{};
+
+  // 参照先が存在しない storyboard は無視する
+  auto missing = test_helper::write_text(dir / "missing.def", "[Info]\nname = \"a\"\n" + std::string{files} +
+                                                                  "[Arcade]\n"
+                                                                  "intro.storyboard = not-existing-file.def\n"
+                                                                  "ending.storyboard = intro\\intro.def\n");
+  auto def = mugen::def::parse(parser, missing, {.followArcade = true});
+  EXPECT_EQ(def.arcade.intro, "not-existing-file.def");
+  EXPECT_FALSE(def.arcade.introStoryboard);
+  // Windows 形式の区切り文字も解決する
+  ASSERT_TRUE(def.arcade.endingStoryboard);
+  EXPECT_EQ(def.arcade.endingStoryboard->sceneCount, 2);
+
+  // パースできない storyboard (spr がない) もキャラクターのパースを失敗させない
+  auto malformed = test_helper::write_text(dir / "malformed.def", "[Info]\nname = \"a\"\n" + std::string{files} +
+                                                                      "[Arcade]\n"
+                                                                      "intro.storyboard = bad.def\n");
+  def = mugen::def::parse(parser, malformed, {.followArcade = true});
+  EXPECT_EQ(def.arcade.intro, "bad.def");
+  EXPECT_FALSE(def.arcade.introStoryboard);
+
+  // キャラクターの def 自体のエラーは例外となる
+  EXPECT_THROW(mugen::def::parse(parser, "assets/bad/missing_anim.def", {.followArcade = true}), mugen::def::MissingKeyError);
+  EXPECT_THROW(mugen::def::parse(parser, "assets/bad/unquoted_name.def", {.followArcade = true}), mugen::def::DequotationError);
+}
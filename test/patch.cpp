@@ -0,0 +1,141 @@
+/**
+ * @file patch.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/patch.hpp>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "helper.hpp"
+
+namespace {
+
+const std::string PATCH_DEF =
+    "; Kung Fu Man\r\n"
+    "[Info]\r\n"
+    "name = \"Kung Fu Man\"   ; name\r\n"
+    "Author=\"Elecbyte\"\r\n"
+    "\r\n"
+    "[Files]\r\n"
+    "cmd = kfm.cmd\r\n"
+    "cns = kfm.cns\r\n"
+    "st = kfm.cns\r\n"
+    "sprite = kfm.sff\r\n"
+    "anim = kfm.air\r\n"
+    "pal1 = kfm.act ; first\r\n"
+    "\r\n"
+    "; trailing comment\r\n";
+
+};  // namespace
+
+TEST(test_patch, raw_value) {
+  mugen::def::DefPatcher patcher{};
+  patcher.load_buffer(PATCH_DEF);
+
+  EXPECT_EQ(patcher.raw_value(mugen::def::DefParseKey::Name), "\"Kung Fu Man\"");
+  EXPECT_EQ(patcher.raw_value(mugen::def::DefParseKey::Author), "\"Elecbyte\"");
+  EXPECT_EQ(patcher.raw_value(mugen::def::DefParseKey::Pal1), "kfm.act");
+  EXPECT_FALSE(patcher.raw_value(mugen::def::DefParseKey::Pal2));
+  EXPECT_FALSE(patcher.raw_value(mugen::def::DefParseKey::Intro));
+  EXPECT_FALSE(patcher.modified());
+}
+
+TEST(test_patch, set_value) {
+  mugen::def::DefPatcher patcher{};
+  patcher.load_buffer(PATCH_DEF);
+
+  // 同じ値は書き換えない
+  patcher.set_value(mugen::def::DefParseKey::Pal1, "kfm.act");
+  EXPECT_FALSE(patcher.modified());
+
+  patcher.set_value(mugen::def::DefParseKey::Author, "Elecbyte Team");
+  patcher.set_value(mugen::def::DefParseKey::Pal1, "pal/kfm1.act");
+  patcher.set_value(mugen::def::DefParseKey::Pal2, "pal/kfm2.act");
+  patcher.set_value(mugen::def::DefParseKey::Intro, "intro.def");
+  EXPECT_TRUE(patcher.modified());
+
+  EXPECT_EQ(patcher.content(),
+            "; Kung Fu Man\r\n"
+            "[Info]\r\n"
+            "name = \"Kung Fu Man\"   ; name\r\n"
+            "Author=\"Elecbyte Team\"\r\n"
+            "\r\n"
+            "[Files]\r\n"
+            "cmd = kfm.cmd\r\n"
+            "cns = kfm.cns\r\n"
+            "st = kfm.cns\r\n"
+            "sprite = kfm.sff\r\n"
+            "anim = kfm.air\r\n"
+            "pal1 = pal/kfm1.act ; first\r\n"
+            "pal2 = pal/kfm2.act\r\n"
+            "\r\n"
+            "; trailing comment\r\n"
+            "[Arcade]\r\n"
+            "intro.storyboard = intro.def\r\n");
+
+  auto def = mugen::def::DefParserWin{}.parse_buffer(patcher.content());
+  EXPECT_EQ(def.info.author, "Elecbyte Team");
+  EXPECT_EQ(def.files.pal2, "pal/kfm2.act");
+  EXPECT_EQ(def.arcade.intro, "intro.def");
+
+  EXPECT_THROW(patcher.set_value(mugen::def::DefParseKey::Cmd, "kfm.cmd\r\n[Info]"), mugen::def::InvalidFormatError);
+  EXPECT_THROW(patcher.set_value(mugen::def::DefParseKey::Name, "\"quoted\""), mugen::def::InvalidFormatError);
+}
+
+TEST(test_patch, line_endings) {
+  // 改行文字は元のファイルに揃え、末尾に改行がなければ補う
+  mugen::def::DefPatcher patcher{};
+  patcher.load_buffer("[Files]\ncmd = kfm.cmd");
+  patcher.set_value(mugen::def::DefParseKey::Cns, "kfm.cns");
+  EXPECT_EQ(patcher.content(), "[Files]\ncmd = kfm.cmd\ncns = kfm.cns\n");
+}
+
+TEST(test_patch, patch_batch) {
+  test_helper::TempDir dir{};
+  std::vector<std::filesystem::path> paths{test_helper::write_text(dir / "1.def", PATCH_DEF), test_helper::write_text(dir / "2.def", PATCH_DEF),
+                                           dir / "not_existing.def"};
+
+  auto results = mugen::def::patch_batch(
+      paths,
+      [&](const std::filesystem::path& path, mugen::def::DefPatcher& patcher) {
+        if (path == paths[0]) {
+          patcher.set_value(mugen::def::DefParseKey::Sprite, "kfm2.sff");
+        }
+      },
+      2);
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_TRUE(results[0] && *results[0].value);
+  EXPECT_TRUE(results[1] && !*results[1].value);
+  EXPECT_FALSE(results[2]);
+  EXPECT_THROW(std::rethrow_exception(results[2].error), mugen::def::FileIOError);
+
+  EXPECT_EQ(mugen::def::DefParserWin{}.parse(paths[0]).files.sprite, "kfm2.sff");
+  EXPECT_EQ(test_helper::read_text(paths[1]), PATCH_DEF);
+
+  // 書き込み用の一時ファイルは残らない
+  for (const auto& entry : std::filesystem::directory_iterator{dir.path()}) {
+    EXPECT_EQ(entry.path().filename().string().find(".mdefparser-"), std::string::npos);
+  }
+}
@@ -0,0 +1,183 @@
+/**
+ * @file scan.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/async.hpp>
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/scan.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+using namespace std::string_view_literals;
+
+TEST(test_scan, find_def_files) {
+  EXPECT_THROW(mugen::def::find_def_files("assets/not-existing-dir"), mugen::def::FileIOError);
+
+  auto single = mugen::def::find_def_files("assets/good/kfm.def");
+  ASSERT_EQ(single.size(), 1);
+
+  auto paths = mugen::def::find_def_files("assets/good");
+  ASSERT_EQ(paths.size(), 4);
+  EXPECT_EQ(paths[0].filename(), "ending.def");
+  EXPECT_EQ(paths[2].filename(), "kfm.def");
+
+  auto all = mugen::def::find_def_files("assets");
+  EXPECT_EQ(all.size(), 14);
+}
+
+TEST(test_scan, key_names) {
+  EXPECT_EQ(mugen::def::key_name(mugen::def::DefParseKey::Name), "name");
+  EXPECT_EQ(mugen::def::key_name(mugen::def::DefParseKey::PalDefaults), "pal.defaults");
+  EXPECT_EQ(mugen::def::find_key("intro.storyboard"), mugen::def::DefParseKey::Intro);
+  EXPECT_EQ(mugen::def::find_key("pal12"), mugen::def::DefParseKey::Pal12);
+  EXPECT_FALSE(mugen::def::find_key("unknown"));
+}
+
+TEST(test_scan, parse_batch) {
+  std::vector<std::filesystem::path> paths{"assets/good/kfm.def", "assets/bad/missing_cmd.def", "assets/good/test.def"};
+
+  auto parser = mugen::def::DefParserWin{};
+  auto results = mugen::def::parse_batch(parser, paths, 3);
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_TRUE(results[0]);
+  EXPECT_EQ(results[0].value->info.name, "Kung Fu Man");
+  EXPECT_FALSE(results[1]);
+  EXPECT_THROW(std::rethrow_exception(results[1].error), mugen::def::MissingKeyError);
+  EXPECT_TRUE(results[2]);
+  EXPECT_EQ(results[2].value->files.sprite, "kfm.pcx");
+
+  std::mutex mutex{};
+  std::vector<bool> seen(paths.size(), false);
+  mugen::def::parse_batch(
+      parser,
+      paths,
+      [&](std::size_t i, mugen::def::BatchResult<mugen::def::MugenDefWin>&& result) {
+        std::lock_guard lock{mutex};
+        seen[i] = true;
+        EXPECT_EQ(static_cast<bool>(result), i != 1);
+      },
+      2);
+  EXPECT_EQ(seen, std::vector<bool>(paths.size(), true));
+}
+
+TEST(test_scan, locality_order) {
+  auto paths = mugen::def::find_def_files("assets");
+  paths.emplace_back("assets/not-existing-file.def");
+
+  auto order = mugen::def::locality_order(paths);
+  ASSERT_EQ(order.size(), paths.size());
+
+  // paths 内の位置の並べ替えになっている
+  auto sorted = order;
+  std::sort(sorted.begin(), sorted.end());
+  for (std::size_t i = 0; i < sorted.size(); ++i) {
+    EXPECT_EQ(sorted[i], i);
+  }
+
+  // 同じフォルダのファイルは続けて読み込む
+  std::vector<std::filesystem::path> parents{};
+  for (auto i : order) {
+    auto parent = paths[i].parent_path();
+    if (parents.empty() || parents.back() != parent) {
+      EXPECT_EQ(std::find(parents.begin(), parents.end(), parent), parents.end());
+      parents.push_back(parent);
+    }
+  }
+
+#ifndef _WIN32
+  // 情報を取得できないファイルは末尾
+  EXPECT_EQ(order.back(), paths.size() - 1);
+#endif
+}
+
+TEST(test_scan, parse_in_locality_order) {
+  auto paths = mugen::def::find_def_files("assets");
+
+  auto parser = mugen::def::DefParserWin{};
+  auto expected = mugen::def::parse_batch(parser, paths, 1);
+
+  std::mutex mutex{};
+  std::vector<bool> seen(paths.size(), false);
+  mugen::def::parse_in_locality_order(
+      paths,
+      parser,
+      [&](std::size_t i, mugen::def::BatchResult<mugen::def::MugenDefWin>&& result) {
+        std::lock_guard lock{mutex};
+        EXPECT_FALSE(seen[i]);
+        seen[i] = true;
+        EXPECT_EQ(static_cast<bool>(result), static_cast<bool>(expected[i]));
+      },
+      3,
+      4);
+  EXPECT_EQ(seen, std::vector<bool>(paths.size(), true));
+}
+
+TEST(test_scan, scan_stream) {
+  EXPECT_THROW(mugen::def::scan_stream("assets/not-existing-dir"), mugen::def::FileIOError);
+
+  auto expected = mugen::def::find_def_files("assets");
+
+  std::vector<std::filesystem::path> paths{};
+  std::size_t succeeded = 0;
+  for (auto& item : mugen::def::scan_stream("assets", 3, 2)) {
+    paths.push_back(item.path);
+    if (item.result) {
+      ++succeeded;
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+  EXPECT_EQ(paths, expected);
+
+  auto parser = mugen::def::DefParserWin{};
+  std::size_t expectedSucceeded = 0;
+  for (const auto& result : mugen::def::parse_batch(parser, expected)) {
+    if (result) {
+      ++expectedSucceeded;
+    }
+  }
+  EXPECT_EQ(succeeded, expectedSucceeded);
+
+  auto single = mugen::def::scan_stream("assets/good/kfm.def");
+  auto it = single.begin();
+  ASSERT_NE(it, single.end());
+  EXPECT_EQ(it->result.value->info.name, "Kung Fu Man");
+  EXPECT_EQ(++it, single.end());
+}
+
+TEST(test_scan, scan_stream_cancel) {
+  // 途中で破棄してもワーカーは終了する
+  for (int i = 0; i < 20; ++i) {
+    auto stream = mugen::def::scan_stream("assets", 4, 2);
+    auto it = stream.begin();
+    ASSERT_NE(it, stream.end());
+  }
+
+  auto stream = mugen::def::scan_stream("assets", mugen::def::DefParserWin{mugen::def::ParseLimits{.maxFileSize = 16}}, 2);
+  for (auto& item : stream) {
+    EXPECT_FALSE(item.result);
+  }
+  stream = mugen::def::scan_stream("assets/good", 1);
+  EXPECT_NE(stream.begin(), stream.end());
+}
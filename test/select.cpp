@@ -0,0 +1,104 @@
+/**
+ * @file scan.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/select.hpp>
+
+#include <filesystem>
+#include <string_view>
+
+#include "helper.hpp"
+
+namespace {
+
+// MUGEN のフォルダ構成を一時フォルダに作る
+std::filesystem::path make_mugen_root(const test_helper::TempDir& dir) {
+  auto root = dir.path();
+  std::filesystem::create_directories(root / "chars" / "kfm");
+  std::filesystem::copy_file("assets/good/kfm.def", root / "chars" / "kfm" / "kfm.def");
+  std::filesystem::copy_file("assets/good/kfm.def", root / "chars" / "kfm" / "kfm720.def");
+  test_helper::write_text(root / "data" / "select.def",
+             "; Select screen\r\n"
+             "[Characters]\r\n"
+             "kfm, stages/kfm.def, music=sound/kfm.mp3, includestage=0\r\n"
+             "randomselect\r\n"
+             "\r\n"
+             "kfm/kfm720.def, random, order=3 ; comment\r\n"
+             "missing\r\n"
+             "[ExtraStages]\r\n"
+             "stages/stage0.def\r\n"
+             "stages/stage1.def\r\n"
+             "[Options]\r\n"
+             "arcade.maxmatches = 6,1,1,0,0,0,0,0,0,0\r\n");
+  return root;
+}
+
+};  // namespace
+
+TEST(test_select, parse) {
+  test_helper::TempDir dir{};
+  auto root = make_mugen_root(dir);
+
+  auto parser = mugen::def::SelectParser{};
+  EXPECT_THROW(parser.parse(root / "data" / "not-existing-file.def"), mugen::def::FileIOError);
+
+  auto select = parser.parse(root / "data" / "select.def");
+  ASSERT_EQ(select.characters.size(), 4);
+
+  const auto& kfm = select.characters[0];
+  EXPECT_EQ(kfm.name, "kfm");
+  EXPECT_FALSE(kfm.randomSelect);
+  EXPECT_EQ(kfm.stage, std::filesystem::path{"stages/kfm.def"});
+  ASSERT_EQ(kfm.options.size(), 2);
+  EXPECT_EQ(kfm.options[0].first, "music");
+  EXPECT_EQ(kfm.options[0].second, "sound/kfm.mp3");
+  EXPECT_EQ(kfm.defPath, root / "chars" / "kfm" / "kfm.def");
+
+  EXPECT_TRUE(select.characters[1].randomSelect);
+  EXPECT_FALSE(select.characters[1].defPath);
+
+  const auto& kfm720 = select.characters[2];
+  EXPECT_EQ(kfm720.stage, std::filesystem::path{"random"});
+  EXPECT_EQ(kfm720.options[0].second, "3");
+  EXPECT_EQ(kfm720.defPath, root / "chars" / "kfm" / "kfm720.def");
+
+  ASSERT_EQ(select.extraStages.size(), 2);
+  EXPECT_EQ(select.extraStages[1], std::filesystem::path{"stages/stage1.def"});
+}
+
+TEST(test_select, load_roster) {
+  test_helper::TempDir dir{};
+  auto root = make_mugen_root(dir);
+  auto select = mugen::def::SelectParser{}.parse(root / "data" / "select.def", root);
+
+  auto parser = mugen::def::DefParserWin{};
+  auto results = mugen::def::load_roster(select, parser, 3);
+  ASSERT_EQ(results.size(), select.characters.size());
+  EXPECT_TRUE(results[0]);
+  EXPECT_EQ(results[0].value->info.name, "Kung Fu Man");
+  EXPECT_FALSE(results[1]);
+  EXPECT_FALSE(results[1].error);
+  EXPECT_TRUE(results[2]);
+  EXPECT_FALSE(results[3]);
+  EXPECT_THROW(std::rethrow_exception(results[3].error), mugen::def::FileIOError);
+}
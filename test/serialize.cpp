@@ -0,0 +1,136 @@
+/**
+ * @file serialize.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/async.hpp>
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/serialize.hpp>
+
+#include <cstddef>
+#include <vector>
+
+using namespace std::string_view_literals;
+
+namespace {
+
+void expect_same_def(const mugen::def::MugenDefWin& a, const mugen::def::MugenDefWin& b) {
+  mugen::def::for_each_key([&](auto key) {
+    const auto& lhs = mugen::def::get_item<key.value>(a);
+    const auto& rhs = mugen::def::get_item<key.value>(b);
+    if constexpr (key.value == mugen::def::DefParseKey::VersionDate || key.value == mugen::def::DefParseKey::MugenVersion) {
+      ASSERT_EQ(lhs.has_value(), rhs.has_value());
+      if (lhs) {
+        EXPECT_EQ(lhs->month, rhs->month);
+        EXPECT_EQ(lhs->day, rhs->day);
+        EXPECT_EQ(lhs->year, rhs->year);
+      }
+    } else {
+      EXPECT_EQ(lhs, rhs) << "key index " << static_cast<int>(key.value);
+    }
+  });
+}
+
+}  // namespace
+
+TEST(test_serialize, round_trip) {
+  static constexpr std::string_view kfmdef = "assets/good/kfm.def"sv;
+  static constexpr std::string_view testdef = "assets/good/test.def"sv;
+
+  auto parser = mugen::def::DefParserWin{};
+  for (auto path : {kfmdef, testdef}) {
+    auto def = parser.parse(path);
+
+    std::vector<std::byte> buffer(mugen::def::serialized_size(def));
+    ASSERT_EQ(mugen::def::serialize(def, buffer), buffer.size());
+
+    std::size_t consumed = 0;
+    auto restored = mugen::def::deserialize(buffer, &consumed);
+    EXPECT_EQ(consumed, buffer.size());
+    expect_same_def(def, restored);
+    EXPECT_FALSE(restored.arcade.introStoryboard);
+  }
+}
+
+TEST(test_serialize, round_trip_storyboard) {
+  static constexpr std::string_view kfmdef = "assets/good/kfm.def"sv;
+
+  auto parser = mugen::def::DefParserWin{};
+  auto def = mugen::def::parse(parser, kfmdef, {.followArcade = true});
+
+  std::vector<std::byte> buffer(mugen::def::serialized_size(def));
+  mugen::def::serialize(def, buffer);
+  auto restored = mugen::def::deserialize(buffer);
+
+  expect_same_def(def, restored);
+  ASSERT_TRUE(restored.arcade.introStoryboard);
+  EXPECT_EQ(restored.arcade.introStoryboard->sprite, "intro.sff");
+  EXPECT_EQ(restored.arcade.introStoryboard->sound, def.arcade.introStoryboard->sound);
+  EXPECT_EQ(restored.arcade.introStoryboard->sceneCount, 2);
+  ASSERT_TRUE(restored.arcade.endingStoryboard);
+  EXPECT_FALSE(restored.arcade.endingStoryboard->sound);
+}
+
+TEST(test_serialize, layout) {
+  static constexpr std::string_view kfmdef = "assets/good/kfm.def"sv;
+
+  auto parser = mugen::def::DefParserWin{};
+  auto def = parser.parse(kfmdef);
+
+  std::vector<std::byte> buffer(mugen::def::serialized_size(def));
+  mugen::def::serialize(def, buffer);
+
+  EXPECT_EQ(static_cast<char>(buffer[0]), 'M');
+  EXPECT_EQ(static_cast<char>(buffer[3]), 'F');
+  EXPECT_EQ(static_cast<std::uint8_t>(buffer[4]), mugen::def::SerializeFormatVersion);
+  EXPECT_EQ(static_cast<std::size_t>(buffer[8]) | (static_cast<std::size_t>(buffer[9]) << 8), buffer.size());
+
+  // name is the first item: length (11) followed by the bytes
+  EXPECT_EQ(static_cast<std::uint8_t>(buffer[20]), 11);
+  EXPECT_EQ(static_cast<char>(buffer[24]), 'K');
+}
+
+TEST(test_serialize, errors) {
+  static constexpr std::string_view kfmdef = "assets/good/kfm.def"sv;
+
+  auto parser = mugen::def::DefParserWin{};
+  auto def = parser.parse(kfmdef);
+
+  std::vector<std::byte> buffer(mugen::def::serialized_size(def));
+  std::vector<std::byte> small(buffer.size() - 1);
+  EXPECT_THROW(mugen::def::serialize(def, small), mugen::def::InsufficientBufferError);
+
+  mugen::def::serialize(def, buffer);
+  EXPECT_THROW(mugen::def::deserialize(std::span{buffer}.first(buffer.size() - 1)), mugen::def::InvalidFormatError);
+  EXPECT_THROW(mugen::def::deserialize(std::span{buffer}.first(10)), mugen::def::InvalidFormatError);
+
+  auto broken = buffer;
+  broken[0] = std::byte{'X'};
+  EXPECT_THROW(mugen::def::deserialize(broken), mugen::def::InvalidFormatError);
+
+  // Concatenated records are decoded one by one
+  auto twice = buffer;
+  twice.insert(twice.end(), buffer.begin(), buffer.end());
+  std::size_t consumed = 0;
+  EXPECT_NO_THROW(mugen::def::deserialize(twice, &consumed));
+  EXPECT_EQ(consumed, buffer.size());
+  EXPECT_NO_THROW(mugen::def::deserialize(std::span{twice}.subspan(consumed)));
+}
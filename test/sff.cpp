@@ -0,0 +1,204 @@
+/**
+ * @file sff.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/sff.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "helper.hpp"
+
+using namespace std::string_view_literals;
+
+static constexpr std::string_view NOT_EXISTING_FILE = "assets/not-existing-file.sff"sv;
+
+namespace {
+
+void put16(std::vector<char>& buf, std::size_t pos, std::uint16_t value) {
+  buf[pos] = static_cast<char>(value & 0xFF);
+  buf[pos + 1] = static_cast<char>(value >> 8);
+}
+
+void put32(std::vector<char>& buf, std::size_t pos, std::uint32_t value) {
+  put16(buf, pos, static_cast<std::uint16_t>(value & 0xFFFF));
+  put16(buf, pos + 2, static_cast<std::uint16_t>(value >> 16));
+}
+
+std::filesystem::path write_file(const std::filesystem::path& path, const std::vector<char>& buf) {
+  return test_helper::write_text(path, std::string_view{buf.data(), buf.size()});
+}
+
+// 3 sprites: (9000,0) 100 bytes, (0,0) 50 bytes, (9000,1) linked to #0
+std::vector<char> make_sff_v1() {
+  std::vector<char> buf(512 + (32 + 100) + (32 + 50) + 32, '\0');
+  std::memcpy(buf.data(), "ElecbyteSpr\0", 12);
+  buf[12] = 0;
+  buf[13] = 1;
+  buf[14] = 0;
+  buf[15] = 1;
+  put32(buf, 16, 2);
+  put32(buf, 20, 3);
+  put32(buf, 24, 512);
+  put32(buf, 28, 32);
+
+  std::uint32_t first = 512;
+  std::uint32_t second = first + 32 + 100;
+  std::uint32_t third = second + 32 + 50;
+
+  put32(buf, first + 0, second);
+  put32(buf, first + 4, 100);
+  put16(buf, first + 12, 9000);
+  put16(buf, first + 14, 0);
+
+  put32(buf, second + 0, third);
+  put32(buf, second + 4, 50);
+  put16(buf, second + 12, 0);
+  put16(buf, second + 14, 0);
+
+  put32(buf, third + 0, 0);
+  put32(buf, third + 4, 0);
+  put16(buf, third + 12, 9000);
+  put16(buf, third + 14, 1);
+  put16(buf, third + 16, 0);
+
+  return buf;
+}
+
+// 3 sprites: (0,0) in ldata, (9000,0) in tdata, (0,0) duplicated
+std::vector<char> make_sff_v2() {
+  std::vector<char> buf(0x200 + 28 * 3 + 64, '\0');
+  std::memcpy(buf.data(), "ElecbyteSpr\0", 12);
+  buf[15] = 2;
+  buf[27] = 2;
+  put32(buf, 0x24, 0x200);
+  put32(buf, 0x28, 3);
+  put32(buf, 0x34, 0x300);
+  put32(buf, 0x38, 32);
+  put32(buf, 0x3C, 0x320);
+  put32(buf, 0x40, 32);
+
+  std::size_t node = 0x200;
+  put16(buf, node + 0, 0);
+  put16(buf, node + 2, 0);
+  put32(buf, node + 16, 0);
+  put32(buf, node + 20, 16);
+  put16(buf, node + 26, 0);
+
+  node += 28;
+  put16(buf, node + 0, 9000);
+  put16(buf, node + 2, 0);
+  put32(buf, node + 16, 8);
+  put32(buf, node + 20, 24);
+  put16(buf, node + 26, 1);
+
+  node += 28;
+  put16(buf, node + 0, 0);
+  put16(buf, node + 2, 0);
+  put32(buf, node + 16, 16);
+  put32(buf, node + 20, 16);
+  put16(buf, node + 26, 0);
+
+  return buf;
+}
+
+}  // namespace
+
+TEST(test_sff, common_read_error) {
+  auto reader = mugen::def::SffReader{};
+  EXPECT_THROW(reader.read_index(NOT_EXISTING_FILE), mugen::def::FileIOError);
+  EXPECT_THROW(reader.read_index("assets/good/kfm.def"sv), mugen::def::InvalidFormatError);
+}
+
+TEST(test_sff, read_v1) {
+  test_helper::TempDir dir{};
+  auto path = write_file(dir / "v1.sff", make_sff_v1());
+
+  auto reader = mugen::def::SffReader{};
+  ASSERT_NO_THROW(reader.read_index(path));
+  auto index = reader.read_index(path);
+
+  EXPECT_EQ(index.version, 1);
+  EXPECT_EQ(index.spriteCount, 3);
+  ASSERT_EQ(index.sprites.size(), 3);
+  EXPECT_EQ(index.count(9000), 2);
+  EXPECT_EQ(index.count(1), 0);
+
+  auto portrait = index.find(9000, 0);
+  ASSERT_TRUE(portrait);
+  EXPECT_EQ(portrait->offset, 512 + 32);
+  EXPECT_EQ(portrait->length, 100);
+
+  auto linked = index.find(9000, 1);
+  ASSERT_TRUE(linked);
+  EXPECT_EQ(linked->offset, 512 + 32);
+  EXPECT_EQ(linked->length, 100);
+
+  EXPECT_FALSE(index.find(9000, 2));
+}
+
+TEST(test_sff, read_v2) {
+  test_helper::TempDir dir{};
+  auto path = write_file(dir / "v2.sff", make_sff_v2());
+
+  auto reader = mugen::def::SffReader{};
+  ASSERT_NO_THROW(reader.read_index(path));
+  auto index = reader.read_index(path);
+
+  EXPECT_EQ(index.version, 2);
+  EXPECT_EQ(index.spriteCount, 3);
+  ASSERT_EQ(index.sprites.size(), 2);
+
+  auto first = index.find(0, 0);
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first->offset, 0x300);
+  EXPECT_EQ(first->length, 16);
+
+  auto portrait = index.find(9000, 0);
+  ASSERT_TRUE(portrait);
+  EXPECT_EQ(portrait->offset, 0x320 + 8);
+  EXPECT_EQ(portrait->length, 24);
+}
+
+TEST(test_sff, read_batch) {
+  test_helper::TempDir dir{};
+  std::vector<std::filesystem::path> paths{write_file(dir / "v1.sff", make_sff_v1()), std::filesystem::path{NOT_EXISTING_FILE},
+                                           write_file(dir / "v2.sff", make_sff_v2())};
+
+  auto reader = mugen::def::SffReader{};
+  auto results = reader.read_index_batch(paths, 2);
+  ASSERT_EQ(results.size(), 3);
+
+  EXPECT_TRUE(results[0]);
+  EXPECT_EQ(results[0].value->version, 1);
+
+  EXPECT_FALSE(results[1]);
+  EXPECT_THROW(std::rethrow_exception(results[1].error), mugen::def::FileIOError);
+
+  EXPECT_TRUE(results[2]);
+  EXPECT_EQ(results[2].value->version, 2);
+}
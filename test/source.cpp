@@ -0,0 +1,107 @@
+/**
+ * @file source.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/async.hpp>
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/source.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "helper.hpp"
+
+TEST(test_source, pread_and_mmap) {
+  auto expected = mugen::def::DefParserWin{}.parse("assets/good/kfm.def");
+
+  auto pread = mugen::def::DefParserWin{std::make_shared<mugen::def::PreadFileSource>()};
+  EXPECT_EQ(pread.parse("assets/good/kfm.def").info.name, expected.info.name);
+
+  auto mmap = mugen::def::DefParserWin{std::make_shared<mugen::def::MmapFileSource>()};
+  auto def = mmap.parse("assets/good/kfm.def");
+  EXPECT_EQ(def.info.author, expected.info.author);
+  EXPECT_EQ(def.files.sprite, expected.files.sprite);
+  EXPECT_EQ(mmap.parse_item<mugen::def::DefParseKey::Cmd>("assets/good/kfm.def"), expected.files.cmd);
+
+  auto stat = mugen::def::MmapFileSource{}.stat("assets/good/kfm.def");
+  ASSERT_TRUE(stat);
+  EXPECT_EQ(stat->size, std::filesystem::file_size("assets/good/kfm.def"));
+  EXPECT_FALSE(mugen::def::MmapFileSource{}.stat("assets/good"));
+
+  EXPECT_THROW(pread.parse("assets/not-existing-file.def"), mugen::def::FileIOError);
+  EXPECT_THROW(mmap.parse("assets/not-existing-file.def"), mugen::def::FileIOError);
+}
+
+TEST(test_source, memory) {
+  auto memory = std::make_shared<mugen::def::MemoryFileSource>();
+  memory->add("chars/kfm/kfm.def", test_helper::read_text("assets/good/kfm.def"));
+
+  auto parser = mugen::def::DefParserWin{memory};
+  EXPECT_EQ(parser.parse("chars/kfm/kfm.def").info.name, "Kung Fu Man");
+  // パスは正規化してから比較する
+  EXPECT_EQ(parser.parse_item<mugen::def::DefParseKey::Name>("chars/./other/../kfm/kfm.def"), "Kung Fu Man");
+  EXPECT_THROW(parser.parse("assets/good/kfm.def"), mugen::def::FileIOError);
+
+  // 登録し直すと modified が変わる
+  auto before = memory->stat("chars/kfm/kfm.def");
+  const std::string content = "[Info]\nname = \"Viewed\"\n[Files]\ncmd = a.cmd\ncns = a.cns\nst = a.cns\nsprite = a.sff\nanim = a.air\n";
+  memory->add_view("chars/kfm/kfm.def", content);
+  auto after = memory->stat("chars/kfm/kfm.def");
+  ASSERT_TRUE(before && after);
+  EXPECT_NE(before->modified, after->modified);
+  EXPECT_EQ(after->size, content.size());
+  EXPECT_EQ(parser.parse("chars/kfm/kfm.def").info.name, "Viewed");
+
+  memory->remove("chars/kfm/kfm.def");
+  EXPECT_FALSE(memory->stat("chars/kfm/kfm.def"));
+}
+
+TEST(test_source, overlay) {
+  auto memory = std::make_shared<mugen::def::MemoryFileSource>();
+  memory->add("assets/good/kfm.def", "[Info]\nname = \"Patched\"\n[Files]\ncmd = a.cmd\ncns = a.cns\nst = a.cns\nsprite = a.sff\nanim = a.air\n");
+
+  auto overlay = std::make_shared<mugen::def::OverlayFileSource>(
+      std::vector<std::shared_ptr<const mugen::def::FileSource>>{memory, std::make_shared<mugen::def::PreadFileSource>()});
+  auto parser = mugen::def::DefParserWin{overlay};
+
+  // 先に重ねたソースが優先される
+  EXPECT_EQ(parser.parse("assets/good/kfm.def").info.name, "Patched");
+  EXPECT_EQ(parser.parse("assets/good/test.def").info.name, mugen::def::DefParserWin{}.parse("assets/good/test.def").info.name);
+  EXPECT_THROW(parser.parse("assets/not-existing-file.def"), mugen::def::FileIOError);
+
+  parser.set_source(nullptr);
+  EXPECT_EQ(parser.parse("assets/good/kfm.def").info.name, "Kung Fu Man");
+}
+
+TEST(test_source, follow_arcade) {
+  auto memory = std::make_shared<mugen::def::MemoryFileSource>();
+  memory->add("chars/kfm/kfm.def", test_helper::read_text("assets/good/kfm.def"));
+  memory->add("chars/kfm/intro.def", test_helper::read_text("assets/good/intro.def"));
+
+  // storyboard も注入したソースから読み込む
+  auto parser = mugen::def::DefParserWin{memory};
+  auto def = mugen::def::parse(parser, "chars/kfm/kfm.def", {.followArcade = true});
+  ASSERT_TRUE(def.arcade.introStoryboard);
+  EXPECT_EQ(def.arcade.introStoryboard->sceneCount, 2);
+  EXPECT_FALSE(def.arcade.endingStoryboard);
+}
@@ -0,0 +1,126 @@
+/**
+ * @file scan.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/zip.hpp>
+
+#include <string>
+
+#include "helper.hpp"
+
+TEST(test_zip, entries) {
+  EXPECT_THROW(mugen::def::ZipArchive{"assets/not-existing-file.zip"}, mugen::def::FileIOError);
+  EXPECT_THROW(mugen::def::ZipArchive{"assets/good/kfm.def"}, mugen::def::InvalidFormatError);
+
+  mugen::def::ZipArchive archive{"assets/zip/kfm.zip"};
+  // ディレクトリのエントリは含まない
+  EXPECT_EQ(archive.entries().size(), 5);
+
+  auto defs = archive.def_entries();
+  ASSERT_EQ(defs.size(), 2);
+  EXPECT_EQ(defs[0]->name, "chars/kfm/kfm.def");
+  EXPECT_EQ(defs[1]->name, "other/BAD.DEF");
+
+  EXPECT_EQ(archive.find("CHARS\\KFM\\KFM.DEF"), defs[0]);
+  EXPECT_EQ(archive.find("chars/kfm/../kfm/kfm.def"), defs[0]);
+  EXPECT_EQ(archive.find("chars/kfm/kfm.sff"), nullptr);
+
+  EXPECT_EQ(archive.read(*archive.find("readme.txt")), std::string(1000, 'x'));
+  EXPECT_THROW(archive.read(*archive.find("readme.txt"), 100), mugen::def::LimitExceededError);
+}
+
+TEST(test_zip, parse_def) {
+  mugen::def::ZipArchive archive{"assets/zip/kfm.zip"};
+  auto parser = mugen::def::DefParserWin{};
+
+  auto def = archive.parse_def(*archive.find("chars/kfm/kfm.def"), parser);
+  EXPECT_EQ(def.info.name, "Kung Fu Man");
+  EXPECT_EQ(def.files.cmd, "kfm.cmd");
+
+  const auto* defEntry = archive.find("chars/kfm/kfm.def");
+  const auto* cmd = archive.find_referenced(*defEntry, def.files.cmd);
+  ASSERT_NE(cmd, nullptr);
+  EXPECT_EQ(archive.read(*cmd), "[Command]\nname = \"a\"\n");
+  EXPECT_EQ(archive.find_referenced(*defEntry, def.files.sprite), nullptr);
+
+  auto results = archive.parse_defs(parser, 2);
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_TRUE(results[0]);
+  EXPECT_EQ(results[0].value->info.author, "Elecbyte");
+  EXPECT_FALSE(results[1]);
+  EXPECT_THROW(std::rethrow_exception(results[1].error), mugen::def::MissingKeyError);
+}
+
+TEST(test_zip, corrupted) {
+  auto bytes = test_helper::read_text("assets/zip/kfm.zip");
+
+  // 無圧縮で格納された kfm.cmd の内容を書き換える
+  auto pos = bytes.find("[Command]");
+  ASSERT_NE(pos, std::string::npos);
+  bytes[pos + 1] = 'c';
+
+  test_helper::TempDir dir{};
+  auto path = test_helper::write_text(dir / "corrupted.zip", bytes);
+
+  mugen::def::ZipArchive archive{path};
+  EXPECT_THROW(archive.read(*archive.find("chars/kfm/kfm.cmd")), mugen::def::InvalidFormatError);
+  EXPECT_NO_THROW(archive.read(*archive.find("chars/kfm/kfm.def")));
+}
+
+TEST(test_zip, parse_buffer) {
+  auto parser = mugen::def::DefParserWin{};
+  auto def = parser.parse_buffer("[Info]\nname = \"Buffer\"\n[Files]\ncmd = a.cmd\ncns = a.cns\nst = a.cns\nsprite = a.sff\nanim = a.air\n");
+  EXPECT_EQ(def.info.name, "Buffer");
+  EXPECT_EQ(def.files.anim, "a.air");
+
+  EXPECT_THROW(parser.parse_buffer("[Info]\nname = \"Buffer\"\n"), mugen::def::MissingKeyError);
+}
+
+TEST(test_zip, cp932_names) {
+  // UTF-8 フラグのない CP932 の名前 (表 = 0x95 0x5C, ア = 0x83 0x41) と UTF-8 フラグ付きの名前を含む
+  mugen::def::ZipArchive archive{"assets/zip/cp932.zip"};
+  EXPECT_EQ(archive.entries().size(), 5);
+
+  const auto* defEntry = archive.find("c/\x95\x5c.def");
+  ASSERT_NE(defEntry, nullptr);
+  EXPECT_EQ(archive.find("C\\\x95\x5c.DEF"), defEntry);
+  // 2 バイト目の英字は小文字にしない
+  EXPECT_NE(archive.find("c/\x83\x41.sff"), nullptr);
+  EXPECT_EQ(archive.find("c/\x83\x61.sff"), nullptr);
+  EXPECT_NE(archive.find("u\\表.txt"), nullptr);
+
+  auto parser = mugen::def::DefParserWin{};
+  auto def = archive.parse_def(*defEntry, parser);
+  EXPECT_EQ(def.info.name, "\x95\x5c");
+
+  // def のあるフォルダは c/\x95 ではなく c
+  const auto* cmd = archive.find_referenced(*defEntry, def.files.cmd);
+  ASSERT_NE(cmd, nullptr);
+  EXPECT_EQ(cmd->name, "c/x.cmd");
+
+  const auto* cns = archive.find_referenced(*defEntry, def.files.cns);
+  ASSERT_NE(cns, nullptr);
+  EXPECT_EQ(archive.read(*cns), "[Statedef 0]\r\n");
+  EXPECT_NE(archive.find_referenced(*defEntry, def.files.sprite), nullptr);
+  EXPECT_EQ(archive.find_referenced(*defEntry, def.files.anim), nullptr);
+}
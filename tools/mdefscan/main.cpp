@@ -0,0 +1,415 @@
+/**
+ * @file main.cpp
+ * @author Halkaze
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mdefparser/mdefparser.h>
+#include <mdefparser/ndjson.hpp>
+#include <mdefparser/scan.hpp>
+#include <mdefparser/serialize.hpp>
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace {
+
+using namespace std::string_view_literals;
+
+enum class OutputFormat {
+  Ndjson,
+  Tsv,
+  Binary,
+};
+
+struct Options {
+  unsigned jobs = 0;
+  OutputFormat format = OutputFormat::Ndjson;
+  mugen::def::DefKeySet keys = mugen::def::DefKeySet{}.set();
+  std::filesystem::path output{};
+  std::vector<std::filesystem::path> inputs{};
+  std::vector<std::filesystem::path> lists{};
+  bool quiet = false;
+};
+
+void print_usage(const char* argv0) {
+  std::cerr << "Usage: " << argv0 << " [options] <dir-or-def>...\n"
+            << "\n"
+            << "Scan MUGEN character .def files in parallel.\n"
+            << "\n"
+            << "Options:\n"
+            << "  -j <n>        number of parallel jobs (default: hardware threads)\n"
+            << "  -f <format>   output format: ndjson (default), tsv, binary\n"
+            << "  -k <keys>     comma separated keys to output (e.g. name,author,sprite)\n"
+            << "  -l <file>     read paths from <file>, one per line (\"-\" for stdin)\n"
+            << "  -o <file>     write output to <file> instead of stdout\n"
+            << "  -q            do not print the summary\n"
+            << "  -h            show this help\n"
+            << "\n"
+            << "binary output is a sequence of records: path length (u32 LE), path (UTF-8), serialized def.\n"
+            << "Keys are ignored for binary output.\n"
+            << "Errors are reported in the summary. Failed paths are also written as NDJSON lines with the ndjson format,\n"
+            << "and to stderr with the other formats.\n";
+}
+
+bool parse_keys(std::string_view list, mugen::def::DefKeySet& keys) {
+  keys.reset();
+  while (!list.empty()) {
+    auto delim = list.find(',');
+    auto name = list.substr(0, delim);
+    auto key = mugen::def::find_key(name);
+    if (!key) {
+      std::cerr << "Unknown key: " << name << std::endl;
+      return false;
+    }
+    keys.set(static_cast<std::size_t>(*key));
+    list = delim == std::string_view::npos ? std::string_view{} : list.substr(delim + 1);
+  }
+  return keys.any();
+}
+
+bool parse_jobs(std::string_view value, unsigned& jobs) {
+  auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), jobs);
+  if (value.empty() || ec != std::errc{} || ptr != value.data() + value.size()) {
+    std::cerr << "Invalid number of jobs: " << value << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+
+    if (arg == "-h"sv || arg == "--help"sv) {
+      return false;
+    } else if (arg == "-q"sv) {
+      options.quiet = true;
+    } else if (arg == "-j"sv) {
+      auto jobs = value();
+      if (!jobs || !parse_jobs(jobs, options.jobs)) {
+        return false;
+      }
+    } else if (arg == "-f"sv) {
+      auto format = value();
+      if (!format) {
+        return false;
+      }
+      if (format == "ndjson"sv) {
+        options.format = OutputFormat::Ndjson;
+      } else if (format == "tsv"sv) {
+        options.format = OutputFormat::Tsv;
+      } else if (format == "binary"sv) {
+        options.format = OutputFormat::Binary;
+      } else {
+        std::cerr << "Unknown format: " << format << std::endl;
+        return false;
+      }
+    } else if (arg == "-k"sv) {
+      auto keys = value();
+      if (!keys || !parse_keys(keys, options.keys)) {
+        return false;
+      }
+    } else if (arg == "-l"sv) {
+      auto list = value();
+      if (!list) {
+        return false;
+      }
+      options.lists.emplace_back(list);
+    } else if (arg == "-o"sv) {
+      auto output = value();
+      if (!output) {
+        return false;
+      }
+      options.output = output;
+    } else if (arg.size() > 1 && arg[0] == '-') {
+      std::cerr << "Unknown option: " << arg << std::endl;
+      return false;
+    } else {
+      options.inputs.emplace_back(arg);
+    }
+  }
+  return !options.inputs.empty() || !options.lists.empty();
+}
+
+void read_list(std::istream& in, std::vector<std::filesystem::path>& paths) {
+  for (std::string line; std::getline(in, line);) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (!line.empty()) {
+      paths.emplace_back(line);
+    }
+  }
+}
+
+std::string_view error_kind(const std::exception_ptr& error) {
+  try {
+    std::rethrow_exception(error);
+  } catch (const mugen::def::FileIOError&) {
+    return "FileIOError"sv;
+  } catch (const mugen::def::MissingKeyError&) {
+    return "MissingKeyError"sv;
+  } catch (const mugen::def::DequotationError&) {
+    return "DequotationError"sv;
+  } catch (const mugen::def::InvalidFormatError&) {
+    return "InvalidFormatError"sv;
+  } catch (const mugen::def::LimitExceededError&) {
+    return "LimitExceededError"sv;
+  } catch (...) {
+    return "OtherError"sv;
+  }
+}
+
+std::string error_message(const std::exception_ptr& error) {
+  try {
+    std::rethrow_exception(error);
+  } catch (const std::exception& e) {
+    return e.what();
+  } catch (...) {
+    return "Unknown error.";
+  }
+}
+
+// TSV の 1 フィールド分を出力する (タブ・改行・バックスラッシュはエスケープする)
+void append_tsv_field(std::string& out, std::string_view value) {
+  for (char c : value) {
+    switch (c) {
+      case '\t':
+        out.append("\\t"sv);
+        break;
+      case '\n':
+        out.append("\\n"sv);
+        break;
+      case '\r':
+        out.append("\\r"sv);
+        break;
+      case '\\':
+        out.append("\\\\"sv);
+        break;
+      default:
+        out.push_back(c);
+        break;
+    }
+  }
+}
+
+void append_tsv_value(std::string& out, const std::string& value) {
+  append_tsv_field(out, value);
+}
+
+void append_tsv_value(std::string& out, const std::filesystem::path& value) {
+  append_tsv_field(out, value.string());
+}
+
+void append_tsv_value(std::string& out, const mugen::def::MugenDefVersion& value) {
+  out.append(std::to_string(value.month)).append(",").append(std::to_string(value.day)).append(",").append(std::to_string(value.year));
+}
+
+void append_tsv_value(std::string& out, const std::vector<std::int32_t>& value) {
+  for (std::size_t i = 0; i < value.size(); ++i) {
+    if (i > 0) {
+      out.push_back(',');
+    }
+    out.append(std::to_string(value[i]));
+  }
+}
+
+void append_tsv_header(std::string& out, const mugen::def::DefKeySet& keys) {
+  out.append("path"sv);
+  mugen::def::for_each_key([&](auto key) {
+    if (keys.test(static_cast<std::size_t>(key.value))) {
+      out.push_back('\t');
+      out.append(mugen::def::DefItemType<key.value>::key);
+    }
+  });
+  out.push_back('\n');
+}
+
+void append_tsv_line(std::string& out, const std::filesystem::path& path, const mugen::def::MugenDefWin& def, const mugen::def::DefKeySet& keys) {
+  append_tsv_field(out, path.string());
+  mugen::def::for_each_key([&](auto key) {
+    if (!keys.test(static_cast<std::size_t>(key.value))) {
+      return;
+    }
+
+    out.push_back('\t');
+    const auto& item = mugen::def::get_item<key.value>(def);
+    if constexpr (mugen::def::is_required_item<key.value>) {
+      append_tsv_value(out, item);
+    } else if (item) {
+      append_tsv_value(out, *item);
+    }
+  });
+  out.push_back('\n');
+}
+
+void append_binary_record(std::string& out, const std::filesystem::path& path, const mugen::def::MugenDefWin& def) {
+  auto u8 = path.u8string();
+  auto length = static_cast<std::uint32_t>(u8.size());
+  for (int i = 0; i < 4; ++i) {
+    out.push_back(static_cast<char>((length >> (8 * i)) & 0xFF));
+  }
+  out.append(reinterpret_cast<const char*>(u8.data()), u8.size());
+
+  auto offset = out.size();
+  out.resize(offset + mugen::def::serialized_size(def));
+  mugen::def::serialize(def, std::as_writable_bytes(std::span{out}.subspan(offset)));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::ios_base::sync_with_stdio(false);
+
+  Options options{};
+  if (!parse_options(argc, argv, options)) {
+    print_usage(argv[0]);
+    return 2;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  // 入力ファイルを集める
+  std::vector<std::filesystem::path> paths{};
+  try {
+    for (const auto& input : options.inputs) {
+      auto found = mugen::def::find_def_files(input);
+      paths.insert(paths.end(), found.begin(), found.end());
+    }
+    for (const auto& list : options.lists) {
+      if (list == "-") {
+        read_list(std::cin, paths);
+      } else {
+        std::ifstream in{list};
+        if (!in) {
+          throw mugen::def::FileIOError{"Can't open the list file: " + list.string()};
+        }
+        read_list(in, paths);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+
+  std::ofstream file{};
+  if (!options.output.empty()) {
+    auto mode = options.format == OutputFormat::Binary ? std::ios_base::out | std::ios_base::binary : std::ios_base::out;
+    file.open(options.output, mode);
+    if (!file) {
+      std::cerr << "Can't open the output file: " << options.output.string() << std::endl;
+      return 2;
+    }
+  }
+  std::ostream& out = options.output.empty() ? std::cout : file;
+
+#ifdef _WIN32
+  // 標準出力はテキストモードなので binary の LF が CRLF に変換されないようにする
+  if (options.output.empty() && options.format == OutputFormat::Binary) {
+    _setmode(_fileno(stdout), _O_BINARY);
+  }
+#endif
+
+  std::mutex outMutex{};
+  std::map<std::string_view, std::size_t> errorCounts{};
+  std::vector<std::pair<std::filesystem::path, std::string>> errorSamples{};
+  std::size_t succeeded = 0;
+
+  if (options.format == OutputFormat::Tsv) {
+    std::string header{};
+    append_tsv_header(header, options.keys);
+    out << header;
+  }
+
+  auto ndjson = mugen::def::NdjsonWriter{out, options.keys};
+
+  // 回転ディスクでのシークを減らすため、ディスク上の配置に近い順に読み込む
+  auto parser = mugen::def::DefParserWin{};
+  mugen::def::parse_in_locality_order(
+      paths,
+      parser,
+      [&](std::size_t i, mugen::def::BatchResult<mugen::def::MugenDefWin>&& result) {
+        // TSV / binary はスレッドごとのバッファで組み立ててから書き込む
+        thread_local std::string buffer{};
+        buffer.clear();
+
+        if (result && options.format == OutputFormat::Tsv) {
+          append_tsv_line(buffer, paths[i], *result.value, options.keys);
+        } else if (result && options.format == OutputFormat::Binary) {
+          append_binary_record(buffer, paths[i], *result.value);
+        }
+
+        std::lock_guard lock{outMutex};
+        if (result) {
+          ++succeeded;
+          if (options.format == OutputFormat::Ndjson) {
+            ndjson.write(paths[i], *result.value);
+          } else {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+          }
+        } else {
+          auto message = error_message(result.error);
+          ++errorCounts[error_kind(result.error)];
+          if (errorSamples.size() < 10) {
+            errorSamples.emplace_back(paths[i], message);
+          }
+          if (options.format == OutputFormat::Ndjson) {
+            ndjson.write_error(paths[i], message);
+          } else {
+            // TSV / binary には失敗を表す行がないので標準エラー出力に書く
+            std::cerr << "error: " << paths[i].string() << ": " << message << '\n';
+          }
+        }
+      },
+      options.jobs);
+
+  out.flush();
+
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::size_t failed = paths.size() - succeeded;
+
+  if (!options.quiet) {
+    std::cerr << "scanned: " << paths.size() << " files, ok: " << succeeded << ", failed: " << failed << std::endl;
+    for (const auto& [kind, count] : errorCounts) {
+      std::cerr << "  " << kind << ": " << count << std::endl;
+    }
+    for (const auto& [path, message] : errorSamples) {
+      std::cerr << "  " << path.string() << ": " << message << std::endl;
+    }
+    std::cerr << "elapsed: " << elapsed << " s (" << (elapsed > 0 ? static_cast<double>(paths.size()) / elapsed : 0.0) << " files/s)" << std::endl;
+  }
+
+  return failed == 0 ? 0 : 1;
+}